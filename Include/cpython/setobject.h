@@ -2,17 +2,14 @@
 #  error "this header file must not be included directly"
 #endif
 
-/* There are three kinds of entries in the table:
+/* The entries of the table are kept in insertion order, as in a dict:
 
-1. Unused:  key == NULL and hash == 0
-2. Dummy:   key == dummy and hash == -1
-3. Active:  key != NULL and key != dummy and hash != -1
+1. Active:  key != NULL and hash is the hash of the key
+2. Deleted: key == NULL and hash == -1
 
-The hash field of Unused slots is always zero.
-
-The hash field of Dummy slots are set to -1
-meaning that dummy entries can be detected by
-either entry->key==dummy or by entry->hash==-1.
+A separate index array maps hash values to positions in the table.  Its
+slots hold -1 if unused and -2 if the entry they referred to was deleted.
+The width of the slots depends on the size of the table.
 */
 
 #define PySet_MINSIZE 8
@@ -36,17 +33,19 @@ Invariants for frozensets:
 typedef struct {
     PyObject_HEAD
 
-    Py_ssize_t fill;            /* Number active and dummy entries*/
+    Py_ssize_t fill;            /* Number active and deleted entries */
     Py_ssize_t used;            /* Number active entries */
 
-    /* The table contains mask + 1 slots, and that's a power of 2.
+    /* The index array contains mask + 1 slots, and that's a power of 2.
      * We store the mask instead of the size because the mask is more
-     * frequently needed.
+     * frequently needed.  The table has room for two thirds as many
+     * entries.
      */
     Py_ssize_t mask;
 
     /* The table points to a fixed-size smalltable for small tables
-     * or to additional malloc'ed memory for bigger tables.
+     * or to additional malloc'ed memory for bigger tables.  The index
+     * array is stored immediately before the first entry.
      * The table pointer is never NULL which saves us from repeated
      * runtime null-tests.
      */
@@ -54,7 +53,8 @@ typedef struct {
     Py_hash_t hash;             /* Only used by frozenset objects */
     Py_ssize_t finger;          /* Search finger for pop() */
 
-    setentry smalltable[PySet_MINSIZE];
+    int8_t smallindices[PySet_MINSIZE];
+    setentry smalltable[(PySet_MINSIZE * 2) / 3];
     PyObject *weakreflist;      /* List of weak references */
 } PySetObject;
 
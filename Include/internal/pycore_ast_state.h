@@ -13,8 +13,6 @@ extern "C" {
 struct ast_state {
     int initialized;
     _PyOnceFlag once;
-    int recursion_depth;
-    int recursion_limit;
     PyObject *AST_type;
     PyObject *Add_singleton;
     PyObject *Add_type;
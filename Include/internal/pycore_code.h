@@ -216,6 +216,8 @@ extern int _PyLineTable_PreviousAddressRange(PyCodeAddressRange *range);
 
 /* Specialization functions */
 
+extern void _PyCode_Quicken(PyCodeObject *code);
+extern void _PyCode_QuickenOnce(PyCodeObject *code);
 extern void _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr,
                                     PyObject *name);
 extern void _Py_Specialize_StoreAttr(PyObject *owner, _Py_CODEUNIT *instr,
@@ -241,6 +243,19 @@ extern void _PyStaticCode_Fini(PyCodeObject *co);
 /* Function to intern strings of codeobjects and quicken the bytecode */
 extern int _PyStaticCode_Init(PyCodeObject *co);
 
+/* Static code objects deep-frozen outside the core
+   (Tools/build/deepfreeze.py --app).  The set is initialized once, on
+   first use, and finalized (and reset) by Py_Finalize(). */
+typedef struct _PyStaticCodeSet {
+    _PyOnceFlag once;
+    int (*init)(void);
+    void (*fini)(void);
+    struct _PyStaticCodeSet *next;
+} _PyStaticCodeSet;
+
+PyAPI_FUNC(int) _PyStaticCode_InitSet(_PyStaticCodeSet *set);
+extern void _PyStaticCode_FiniSets(void);
+
 #ifdef Py_STATS
 
 
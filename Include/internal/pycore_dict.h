@@ -42,6 +42,9 @@ extern uint32_t _PyDictKeys_GetVersionForCurrentState(PyDictKeysObject *dictkeys
 
 extern size_t _PyDict_KeysSize(PyDictKeysObject *keys);
 
+extern PyObject *_PyDict_GetLayoutStats(void);
+extern void _PyDict_MergeLayoutStats(PyThreadState *tstate);
+
 /* _Py_dict_lookup() returns index of entry which can be used like DK_ENTRIES(dk)[index].
  * -1 when no entry found, -3 when compare raises error.
  */
@@ -57,6 +60,10 @@ extern int _PyObjectDict_SetItem(PyTypeObject *tp, PyObject **dictptr, PyObject
 
 extern PyObject *_PyDict_Pop_KnownHash(PyObject *, PyObject *, Py_hash_t, PyObject *);
 
+/* Return new references, used by _collections.ConcurrentDict */
+extern PyObject *_PyDict_FetchItem_KnownHash(PyObject *, PyObject *, Py_hash_t);
+extern PyObject *_PyDict_SetDefault_KnownHash(PyObject *, PyObject *, Py_hash_t, PyObject *);
+
 #define DKIX_EMPTY (-1)
 #define DKIX_DUMMY (-2)  /* Used internally */
 #define DKIX_ERROR (-3)
@@ -94,7 +101,8 @@ struct _dictkeysobject {
     /* Actual hash table of dk_size entries. It holds indices in dk_entries,
        or DKIX_EMPTY(-1) or DKIX_DUMMY(-2).
 
-       Indices must be: 0 <= indice < USABLE_FRACTION(dk_size).
+       Indices must be: 0 <= indice < USABLE_FRACTION(dk_size).  Tables
+       with 4-byte indices keep hash bits above log2(dk_size) in them.
 
        The size in bytes of an indice depends on dk_size:
 
@@ -113,6 +121,9 @@ struct _dictkeysobject {
 typedef struct PyDictSharedKeysObject {
     uint8_t tracked;
     uint8_t marked;
+    /* Set once attribute names found in the methods of the class have been
+       added, when its first instance is created */
+    uint8_t prepopulated;
     struct PyDictSharedKeysObject *next;
     struct _dictkeysobject keys;
 } PyDictSharedKeysObject;
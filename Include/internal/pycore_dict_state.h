@@ -31,8 +31,25 @@ struct _Py_dict_runtime_state {
 
 typedef struct PyDictSharedKeysObject PyDictSharedKeysObject;
 
+/* How instance dicts use the shared keys of their class, reported by
+   sys._dict_layout_stats().  Each thread counts in its own dict state, and
+   the counts of a thread are added to the interpreter's when it exits. */
+struct _Py_dict_layout_stats {
+    /* Instance dicts converted from shared keys to a combined table */
+    Py_ssize_t unshared;
+    /* ... because the shared keys had no room for a new key */
+    Py_ssize_t unshared_keys_full;
+    /* ... because a key was not an interned str */
+    Py_ssize_t unshared_incompatible_key;
+    /* Instance dicts created from inline values */
+    Py_ssize_t materialized;
+    /* Keys added to shared keys before the first instance was created */
+    Py_ssize_t prepopulated_keys;
+};
+
 struct _Py_dict_thread_state {
     uint64_t dict_version;
+    struct _Py_dict_layout_stats layout_stats;
 #if PyDict_MAXFREELIST > 0
     /* Dictionary reuse scheme to save calls to malloc and free */
     PyDictObject *free_list[PyDict_MAXFREELIST];
@@ -46,6 +63,8 @@ struct _Py_dict_state {
     PyDict_WatchCallback watchers[DICT_MAX_WATCHERS];
     /* shared keys from deallocated types (i.e., potentially dead) */
     PyDictSharedKeysObject *tracked_shared_keys;
+    /* layout stats of the threads that exited (protected by HEAD_LOCK) */
+    struct _Py_dict_layout_stats layout_stats;
 };
 
 
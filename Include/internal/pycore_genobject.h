@@ -11,9 +11,11 @@ extern "C" {
 extern PyObject *_PyGen_yf(PyGenObject *);
 extern PyObject *_PyCoro_GetAwaitableIter(PyObject *o);
 extern PyObject *_PyAsyncGenValueWrapperNew(PyThreadState *state, PyObject *);
+extern void _PyGen_DebugMallocStats(FILE *out);
 
 /* runtime lifecycle */
 
+extern void _PyGen_Fini(PyThreadState *);
 extern void _PyAsyncGen_Fini(PyThreadState *);
 
 
@@ -21,9 +23,36 @@ extern void _PyAsyncGen_Fini(PyThreadState *);
 
 #ifndef WITH_FREELISTS
 // without freelists
+#  define _PyGen_NFREELISTS 0
 #  define _PyAsyncGen_MAXFREELIST 0
 #endif
 
+// _PyGen_NFREELISTS - number of generator size classes to pool
+// _PyGen_MAXFREELIST - maximum number of objects kept per size class
+// _PyGen_FREELIST_SLOTS - frame slots covered by each size class
+#ifndef _PyGen_NFREELISTS
+#  define _PyGen_NFREELISTS 16
+#endif
+#ifndef _PyGen_MAXFREELIST
+#  define _PyGen_MAXFREELIST 32
+#endif
+#define _PyGen_FREELIST_SLOTS 8
+
+struct _Py_gen_state {
+#if _PyGen_NFREELISTS > 0
+    /* Generators, coroutines and async generators share one layout with
+       the frame embedded at the end, so freed objects are pooled by the
+       size of that frame.  Size class i holds objects with room for
+       (i + 1) * _PyGen_FREELIST_SLOTS frame slots; they are linked
+       through gi_code.  Asyncio-style code creates and drops a coroutine
+       for nearly every call, so this saves an allocation per call. */
+    PyGenObject *free_list[_PyGen_NFREELISTS];
+    int numfree[_PyGen_NFREELISTS];
+#else
+    char _unused;  // Empty structs are not allowed.
+#endif
+};
+
 #ifndef _PyAsyncGen_MAXFREELIST
 #  define _PyAsyncGen_MAXFREELIST 80
 #endif
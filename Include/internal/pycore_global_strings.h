@@ -384,6 +384,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(exc_value)
         STRUCT_FOR_ID(excepthook)
         STRUCT_FOR_ID(exception)
+        STRUCT_FOR_ID(exec_module)
         STRUCT_FOR_ID(exp)
         STRUCT_FOR_ID(extend)
         STRUCT_FOR_ID(facility)
@@ -495,6 +496,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(listcomp)
         STRUCT_FOR_ID(little)
         STRUCT_FOR_ID(lo)
+        STRUCT_FOR_ID(loader)
         STRUCT_FOR_ID(locale)
         STRUCT_FOR_ID(locals)
         STRUCT_FOR_ID(logoption)
@@ -564,6 +566,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(owner)
         STRUCT_FOR_ID(p)
         STRUCT_FOR_ID(pages)
+        STRUCT_FOR_ID(parallel)
         STRUCT_FOR_ID(parent)
         STRUCT_FOR_ID(password)
         STRUCT_FOR_ID(path)
@@ -19,7 +19,7 @@ extern "C" {
 #include "pycore_exceptions.h"    // struct _Py_exc_state
 #include "pycore_floatobject.h"   // struct _Py_float_state
 #include "pycore_function.h"      // FUNC_MAX_WATCHERS
-#include "pycore_genobject.h"     // struct _Py_async_gen_state
+#include "pycore_genobject.h"     // struct _Py_gen_state
 #include "pycore_gc.h"            // struct _gc_runtime_state
 #include "pycore_list.h"          // struct _Py_list_state
 #include "pycore_llist.h"         // struct llist_node
@@ -73,6 +73,7 @@ typedef struct PyThreadStateImpl {
     struct _Py_tuple_state tuple;
     struct _Py_list_state list;
     struct _Py_dict_thread_state dict_state;
+    struct _Py_gen_state gen;
     struct _Py_async_gen_state async_gen;
     struct _Py_context_state context;
 
@@ -81,6 +82,11 @@ typedef struct PyThreadStateImpl {
     struct qsbr *qsbr;
 
     _PyObjectQueue *cached_queue;
+
+    /* Most recently popped data stack chunk, kept for the next push_chunk()
+       so that recursion oscillating around a chunk boundary does not
+       allocate and free a chunk on every call. */
+    _PyStackChunk *datastack_cached_chunk;
 } PyThreadStateImpl;
 
 
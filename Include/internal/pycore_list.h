@@ -15,6 +15,7 @@ extern "C" {
 /* runtime lifecycle */
 
 extern void _PyList_Fini(PyThreadState *);
+extern void _PyList_AfterFork(void);
 
 
 /* other API */
@@ -38,6 +39,10 @@ struct _Py_list_state {
 
 #define _PyList_ITEMS(op) _Py_RVALUE(_PyList_CAST(op)->ob_item)
 
+/* Set the number of threads list.sort(parallel=True) uses, 0 for one per
+   online CPU, and return the previous setting.  For tests. */
+PyAPI_FUNC(Py_ssize_t) _PyList_SetParallelSortThreads(Py_ssize_t n);
+
 // append without acquiring lock
 PyAPI_FUNC(int) _PyList_AppendPrivate(PyObject *, PyObject *);
 
@@ -53,8 +58,8 @@ _PyList_AppendTakeRef(PyListObject *self, PyObject *newitem)
     Py_ssize_t allocated = self->allocated;
     assert((size_t)len + 1 < PY_SSIZE_T_MAX);
     if (allocated > len) {
-        PyList_SET_ITEM(self, len, newitem);
-        Py_SET_SIZE(self, len + 1);
+        _Py_atomic_store_ptr_relaxed(&self->ob_item[len], newitem);
+        _Py_atomic_store_ssize_release(&((PyVarObject *)self)->ob_size, len + 1);
         return 0;
     }
     return _PyList_AppendTakeRefListResize(self, newitem);
@@ -17,6 +17,10 @@ typedef struct {
     // for logging purposes after md_dict is cleared
     PyObject *md_name;
     int md_initialized;
+    // Copy of md_dict made by _PyModule_SetLazy(), until the module is loaded
+    PyObject *md_lazy;
+    // Id of the thread executing a lazy module, or 0
+    uintptr_t md_lazy_owner;
 } PyModuleObject;
 
 static inline PyModuleDef* _PyModule_GetDef(PyObject *mod) {
@@ -29,6 +33,13 @@ static inline void* _PyModule_GetState(PyObject* mod) {
     return ((PyModuleObject *)mod)->md_state;
 }
 
+static inline int _PyModule_IsLazy(PyObject *mod) {
+    assert(PyModule_Check(mod));
+    return _Py_atomic_load_ptr(&((PyModuleObject *)mod)->md_lazy) != NULL;
+}
+
+extern PyObject* _PyModule_SetLazy(PyObject *mod);
+
 static inline PyObject* _PyModule_GetDict(PyObject *mod) {
     assert(PyModule_Check(mod));
     PyObject *dict = ((PyModuleObject *)mod) -> md_dict;
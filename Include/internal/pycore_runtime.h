@@ -171,6 +171,8 @@ typedef struct pyruntimestate {
     struct _ceval_runtime_state ceval;
     struct _gilstate_runtime_state gilstate;
     struct _getargs_runtime_state getargs;
+    /* Deep-frozen code outside the core, see _PyStaticCode_InitSet() */
+    struct _PyStaticCodeSet *static_code_sets;
     struct _dtoa_runtime_state dtoa;
     struct _fileutils_state fileutils;
     struct _faulthandler_runtime_state faulthandler;
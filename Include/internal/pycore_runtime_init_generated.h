@@ -890,6 +890,7 @@ extern "C" {
     INIT_ID(exc_value), \
     INIT_ID(excepthook), \
     INIT_ID(exception), \
+    INIT_ID(exec_module), \
     INIT_ID(exp), \
     INIT_ID(extend), \
     INIT_ID(facility), \
@@ -1001,6 +1002,7 @@ extern "C" {
     INIT_ID(listcomp), \
     INIT_ID(little), \
     INIT_ID(lo), \
+    INIT_ID(loader), \
     INIT_ID(locale), \
     INIT_ID(locals), \
     INIT_ID(logoption), \
@@ -1070,6 +1072,7 @@ extern "C" {
     INIT_ID(owner), \
     INIT_ID(p), \
     INIT_ID(pages), \
+    INIT_ID(parallel), \
     INIT_ID(parent), \
     INIT_ID(password), \
     INIT_ID(path), \
@@ -674,6 +674,8 @@ _PyUnicode_InitStaticStrings(void) {
     PyUnicode_InternInPlace(&string);
     string = &_Py_ID(exception);
     PyUnicode_InternInPlace(&string);
+    string = &_Py_ID(exec_module);
+    PyUnicode_InternInPlace(&string);
     string = &_Py_ID(exp);
     PyUnicode_InternInPlace(&string);
     string = &_Py_ID(extend);
@@ -896,6 +898,8 @@ _PyUnicode_InitStaticStrings(void) {
     PyUnicode_InternInPlace(&string);
     string = &_Py_ID(lo);
     PyUnicode_InternInPlace(&string);
+    string = &_Py_ID(loader);
+    PyUnicode_InternInPlace(&string);
     string = &_Py_ID(locale);
     PyUnicode_InternInPlace(&string);
     string = &_Py_ID(locals);
@@ -1034,6 +1038,8 @@ _PyUnicode_InitStaticStrings(void) {
     PyUnicode_InternInPlace(&string);
     string = &_Py_ID(pages);
     PyUnicode_InternInPlace(&string);
+    string = &_Py_ID(parallel);
+    PyUnicode_InternInPlace(&string);
     string = &_Py_ID(parent);
     PyUnicode_InternInPlace(&string);
     string = &_Py_ID(password);
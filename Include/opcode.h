@@ -182,19 +182,20 @@ extern "C" {
 #define LOAD_GLOBAL_GENERIC                    141
 #define LOAD_GLOBAL_BUILTIN                    143
 #define LOAD_GLOBAL_MODULE                     153
-#define STORE_ATTR_GENERIC                     154
-#define STORE_ATTR_INSTANCE_VALUE              158
-#define STORE_ATTR_SLOT                        159
-#define STORE_ATTR_WITH_HINT                   160
-#define STORE_FAST__LOAD_FAST                  161
-#define STORE_FAST__STORE_FAST                 166
-#define STORE_SUBSCR_GENERIC                   167
-#define STORE_SUBSCR_DICT                      168
-#define STORE_SUBSCR_LIST_INT                  169
-#define UNPACK_SEQUENCE_GENERIC                170
-#define UNPACK_SEQUENCE_LIST                   174
-#define UNPACK_SEQUENCE_TUPLE                  175
-#define UNPACK_SEQUENCE_TWO_TUPLE              176
+#define RESUME_QUICKEN                         154
+#define STORE_ATTR_GENERIC                     158
+#define STORE_ATTR_INSTANCE_VALUE              159
+#define STORE_ATTR_SLOT                        160
+#define STORE_ATTR_WITH_HINT                   161
+#define STORE_FAST__LOAD_FAST                  166
+#define STORE_FAST__STORE_FAST                 167
+#define STORE_SUBSCR_GENERIC                   168
+#define STORE_SUBSCR_DICT                      169
+#define STORE_SUBSCR_LIST_INT                  170
+#define UNPACK_SEQUENCE_GENERIC                174
+#define UNPACK_SEQUENCE_LIST                   175
+#define UNPACK_SEQUENCE_TUPLE                  176
+#define UNPACK_SEQUENCE_TWO_TUPLE              177
 #define DO_TRACING                             255
 
 #define HAS_ARG(op) ((((op) >= HAVE_ARGUMENT) && (!IS_PSEUDO_OPCODE(op)))\
@@ -295,6 +295,9 @@ _Py_atomic_store_uint64_release(volatile uint64_t *address, uint64_t value);
 static inline void
 _Py_atomic_store_ptr_release(volatile void *address, void *value);
 
+static inline void
+_Py_atomic_store_ssize_release(volatile Py_ssize_t *address, Py_ssize_t value);
+
 
  static inline void
 _Py_atomic_fence_seq_cst(void);
@@ -577,6 +577,12 @@ _Py_atomic_store_ptr_release(volatile void *address, void *value)
     __atomic_store_n((volatile void **)address, value, __ATOMIC_RELEASE);
 }
 
+static inline void
+_Py_atomic_store_ssize_release(volatile Py_ssize_t *address, Py_ssize_t value)
+{
+    __atomic_store_n(address, value, __ATOMIC_RELEASE);
+}
+
  static inline void
 _Py_atomic_fence_seq_cst(void)
 {
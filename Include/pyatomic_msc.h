@@ -740,6 +740,18 @@ _Py_atomic_store_ptr_release(volatile void* address, void* value)
 #else
 #error no implementation of _Py_atomic_store_ptr_release
 #endif
+}
+
+static inline void
+_Py_atomic_store_ssize_release(volatile Py_ssize_t* address, Py_ssize_t value)
+{
+#if defined(_M_X64) || defined(_M_IX86)
+    *address = value;
+#elif defined(_M_ARM64)
+    __stlr64((volatile unsigned __int64*)address, (unsigned __int64)value);
+#else
+#error no implementation of _Py_atomic_store_ssize_release
+#endif
 }
 
  static inline void
@@ -682,6 +682,13 @@ _Py_atomic_store_ptr_release(volatile void *address, void *value)
     atomic_store_explicit((volatile _Atomic(void*)*)address, value, memory_order_release);
 }
 
+static inline void
+_Py_atomic_store_ssize_release(volatile Py_ssize_t *address, Py_ssize_t value)
+{
+    MI_USING_STD
+    atomic_store_explicit((volatile _Atomic(Py_ssize_t)*)address, value, memory_order_release);
+}
+
  static inline void
 _Py_atomic_fence_seq_cst(void)
 {
@@ -45,6 +45,7 @@ typedef struct _call_stats {
     uint64_t pyeval_calls;
     uint64_t frames_pushed;
     uint64_t frame_objects_created;
+    uint64_t frame_objects_for_traceback;
     uint64_t eval_calls[EVAL_CALL_KINDS];
 } CallStats;
 
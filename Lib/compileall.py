@@ -73,7 +73,7 @@ def compile_dir(dir, maxlevels=None, ddir=None, force=False,
                    the defined path
     hardlink_dupes: hardlink duplicated pyc files
     """
-    ProcessPoolExecutor = None
+    Executor = None
     if ddir is not None and (stripdir is not None or prependdir is not None):
         raise ValueError(("Destination dir (ddir) cannot be used "
                           "in combination with stripdir or prependdir"))
@@ -84,22 +84,31 @@ def compile_dir(dir, maxlevels=None, ddir=None, force=False,
     if workers < 0:
         raise ValueError('workers must be greater or equal to 0')
     if workers != 1:
-        # Check if this is a system where ProcessPoolExecutor can function.
-        from concurrent.futures.process import _check_system_limits
-        try:
-            _check_system_limits()
-        except NotImplementedError:
-            workers = 1
+        if sys.flags.nogil:
+            # Without the GIL the parser and the compiler run in parallel
+            # on threads, which avoids starting processes and pickling
+            # the arguments and results.
+            from concurrent.futures import ThreadPoolExecutor as Executor
+            # If workers == 0, use one thread per core
+            workers = workers or os.cpu_count() or 1
         else:
-            from concurrent.futures import ProcessPoolExecutor
+            # Check if this is a system where ProcessPoolExecutor can
+            # function.
+            from concurrent.futures.process import _check_system_limits
+            try:
+                _check_system_limits()
+            except NotImplementedError:
+                workers = 1
+            else:
+                from concurrent.futures import ProcessPoolExecutor as Executor
+                # If workers == 0, let ProcessPoolExecutor choose
+                workers = workers or None
     if maxlevels is None:
         maxlevels = sys.getrecursionlimit()
     files = _walk_dir(dir, quiet=quiet, maxlevels=maxlevels)
     success = True
-    if workers != 1 and ProcessPoolExecutor is not None:
-        # If workers == 0, let ProcessPoolExecutor choose
-        workers = workers or None
-        with ProcessPoolExecutor(max_workers=workers) as executor:
+    if workers != 1 and Executor is not None:
+        with Executor(max_workers=workers) as executor:
             results = executor.map(partial(compile_file,
                                            ddir=ddir, force=force,
                                            rx=rx, quiet=quiet,
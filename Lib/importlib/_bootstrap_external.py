@@ -428,6 +428,7 @@ def _write_atomic(path, data, mode=0o666):
 #     Python 3.12a1 3512 (Remove all unused consts from code objects)
 #     Python 3.12a1 3513 (Add CALL_INTRINSIC_1 instruction, removed STOPITERATION_ERROR, PRINT_EXPR, IMPORT_STAR)
 #     Python 3.12a1 3514 (Remove ASYNC_GEN_WRAP, LIST_TO_TUPLE, and UNARY_POSITIVE)
+#     Python 3.12a1 3517 (CALL_FUNCTION_EX forwards a function's own **kwargs uncopied)
 
 #     Python 3.13 will start with 3550
 
@@ -440,7 +441,7 @@ def _write_atomic(path, data, mode=0o666):
 # Whenever MAGIC_NUMBER is changed, the ranges in the magic_values array
 # in PC/launcher.c must also be updated.
 
-MAGIC_NUMBER = (3516).to_bytes(2, 'little') + b'\r\n'
+MAGIC_NUMBER = (3517).to_bytes(2, 'little') + b'\r\n'
 
 _RAW_MAGIC_NUMBER = int.from_bytes(MAGIC_NUMBER, 'little')  # For import.c
 
@@ -1443,6 +1444,84 @@ def get_resource_reader(self, module):
 _NamespaceLoader = NamespaceLoader
 
 
+# Path index ##################################################################
+
+class _PathIndex:
+
+    """Directory listings of path entries, persisted across processes.
+
+    Enabled by setting the PYTHONPATHINDEX environment variable to the name
+    of the index file.  Each listing is stored along with the mtime of its
+    directory and is only used while the directory still has that mtime, so
+    FileFinder can skip listdir() for directories that have not changed.
+    zipimport stores the parsed directories of zip archives the same way.
+    Entries made by this process are merged into the file at exit.
+
+    """
+
+    def __init__(self, filename):
+        self.filename = filename
+        self._entries = None
+        self._updated = {}
+
+    def _read(self):
+        try:
+            with _io.FileIO(self.filename, 'r') as file:
+                data = file.read()
+                index_mtime = _os.stat(file.fileno()).st_mtime
+            magic, entries = marshal.loads(data)
+            if magic != MAGIC_NUMBER:
+                return {}
+            # A directory modified in the same clock tick as the index was
+            # written may have changed after it was listed.
+            return {path: (mtime, contents)
+                    for path, (mtime, contents) in entries.items()
+                    if mtime < index_mtime}
+        except (OSError, EOFError, ValueError, TypeError, AttributeError):
+            return {}
+
+    def get(self, path, mtime, read):
+        """Return read(path) for the file or directory 'path' whose mtime is
+        'mtime', using the stored result if there is one.
+
+        The result must be marshallable and is shared by all callers.
+        """
+        if self._entries is None:
+            self._entries = self._read()
+        entry = self._entries.get(path)
+        if entry is not None and entry[0] == mtime:
+            return entry[1]
+        result = read(path)
+        self._entries[path] = self._updated[path] = (mtime, result)
+        if len(self._updated) == 1:
+            import atexit
+            atexit.register(self.save)
+        return result
+
+    def listdir(self, path, mtime):
+        """Return the contents of the directory 'path' whose mtime is 'mtime'.
+
+        OSError is raised if the directory cannot be listed.
+        """
+        return self.get(path, mtime, lambda path: tuple(_os.listdir(path)))
+
+    def save(self):
+        """Merge the listings made by this process into the index file."""
+        if not self._updated:
+            return
+        entries = self._read()
+        entries.update(self._updated)
+        self._updated = {}
+        try:
+            _write_atomic(self.filename, marshal.dumps((MAGIC_NUMBER, entries)))
+        except OSError:
+            pass
+
+
+# Set by _install() if PYTHONPATHINDEX is set.
+_path_index = None
+
+
 # Finders #####################################################################
 
 class PathFinder:
@@ -1670,7 +1749,7 @@ def find_spec(self, fullname, target=None):
         except OSError:
             mtime = -1
         if mtime != self._path_mtime:
-            self._fill_cache()
+            self._fill_cache(mtime)
             self._path_mtime = mtime
         # tail_module keeps the original casing, for __file__ and friends
         if _relax_case():
@@ -1709,11 +1788,17 @@ def find_spec(self, fullname, target=None):
             return spec
         return None
 
-    def _fill_cache(self):
-        """Fill the cache of potential modules and packages for this directory."""
-        path = self.path
+    def _fill_cache(self, mtime=-1):
+        """Fill the cache of potential modules and packages for this directory.
+
+        'mtime' is the current mtime of the directory, if known.
+        """
         try:
-            contents = _os.listdir(path or _os.getcwd())
+            path = self.path or _os.getcwd()
+            if _path_index is not None and mtime != -1:
+                contents = _path_index.listdir(path, mtime)
+            else:
+                contents = _os.listdir(path)
         except (FileNotFoundError, PermissionError, NotADirectoryError):
             # Directory has either been removed, turned into a file, or made
             # unreadable.
@@ -1811,3 +1896,23 @@ def _install(_bootstrap_module):
     supported_loaders = _get_supported_file_loaders()
     sys.path_hooks.extend([FileFinder.path_hook(*supported_loaders)])
     sys.meta_path.append(PathFinder)
+    _install_path_index()
+
+
+def _install_path_index():
+    global _path_index
+    if sys.flags.ignore_environment:
+        return
+    if _MS_WINDOWS:
+        filename = _os.environ.get('PYTHONPATHINDEX')
+    else:
+        filename = _os.environ.get(b'PYTHONPATHINDEX')
+        if filename:
+            try:
+                filename = filename.decode(sys.getfilesystemencoding(),
+                                           sys.getfilesystemencodeerrors())
+            except (UnicodeError, LookupError):
+                # The codecs may not be available yet.
+                return
+    if filename:
+        _path_index = _PathIndex(filename)
@@ -4,6 +4,7 @@
 from ._bootstrap import _resolve_name
 from ._bootstrap import spec_from_loader
 from ._bootstrap import _find_spec
+from ._bootstrap import _gcd_import
 from ._bootstrap_external import MAGIC_NUMBER
 from ._bootstrap_external import _RAW_MAGIC_NUMBER
 from ._bootstrap_external import cache_from_source
@@ -13,7 +14,6 @@
 
 import _imp
 import sys
-import types
 
 
 def source_hash(source_bytes):
@@ -112,50 +112,64 @@ def find_spec(name, package=None):
             return spec
 
 
-class _LazyModule(types.ModuleType):
-
-    """A subclass of the module type which triggers loading upon attribute access."""
-
-    def __getattribute__(self, attr):
-        """Trigger the load of the module and return the attribute."""
-        # All module metadata must be garnered from __spec__ in order to avoid
-        # using mutated values.
-        # Stop triggering this method.
-        self.__class__ = types.ModuleType
-        # Get the original name to make sure no object substitution occurred
-        # in sys.modules.
-        original_name = self.__spec__.name
-        # Figure out exactly what attributes were mutated between the creation
-        # of the module and now.
-        attrs_then = self.__spec__.loader_state['__dict__']
-        attrs_now = self.__dict__
-        attrs_updated = {}
-        for key, value in attrs_now.items():
-            # Code that set the attribute may have kept a reference to the
-            # assigned object, making identity more important than equality.
-            if key not in attrs_then:
-                attrs_updated[key] = value
-            elif id(attrs_now[key]) != id(attrs_then[key]):
-                attrs_updated[key] = value
-        self.__spec__.loader.exec_module(self)
-        # If exec_module() was used directly there is no guarantee the module
-        # object was put into sys.modules.
-        if original_name in sys.modules:
-            if id(self) != id(sys.modules[original_name]):
-                raise ValueError(f"module object for {original_name!r} "
-                                  "substituted in sys.modules during a lazy "
-                                  "load")
-        # Update after loading since that's what would happen in an eager
-        # loading situation.
-        self.__dict__.update(attrs_updated)
-        return getattr(self, attr)
-
-    def __delattr__(self, attr):
-        """Trigger the load and then perform the deletion."""
-        # To trigger the load and raise an exception if the attribute
-        # doesn't exist.
-        self.__getattribute__(attr)
-        delattr(self, attr)
+def import_parallel(names, package=None, *, max_workers=None):
+    """Import the named modules using a pool of threads.
+
+    Each name is imported as if by importlib.import_module(); the imported
+    modules are returned as a list in the order of *names*.  At most
+    *max_workers* threads are used; by default that is the same number as
+    concurrent.futures.ThreadPoolExecutor would use.
+
+    The per-module import locks still apply, so a module that several of
+    the named modules depend on is only executed once.  Beyond that the
+    named modules should be independent of each other: as with any
+    concurrent import, a circular import that spans two threads may see a
+    partially initialized module.
+
+    If an import fails, all the other imports are still allowed to finish
+    and then the exception for the first failing name is raised.
+
+    """
+    fullnames = [resolve_name(name, package) for name in names]
+    pending = [fullname for fullname in fullnames
+               if fullname not in sys.modules]
+    if max_workers is None:
+        import os
+        max_workers = min(32, (os.cpu_count() or 1) + 4)
+    elif max_workers <= 0:
+        raise ValueError("max_workers must be greater than 0")
+    errors = {}
+    def import_one(fullname):
+        try:
+            _gcd_import(fullname)
+        except BaseException as exc:
+            errors.setdefault(fullname, exc)
+    if len(pending) > 1 and max_workers > 1:
+        import threading
+        remaining = iter(pending)
+        lock = threading.Lock()
+        def worker():
+            while True:
+                with lock:
+                    fullname = next(remaining, None)
+                if fullname is None:
+                    return
+                import_one(fullname)
+        threads = [threading.Thread(target=worker,
+                                    name=f'import_parallel_{i}')
+                   for i in range(min(max_workers, len(pending)))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+    else:
+        for fullname in pending:
+            import_one(fullname)
+    for fullname in fullnames:
+        if fullname in errors:
+            raise errors[fullname]
+    # Every module is in sys.modules by now, so this only looks them up.
+    return [_gcd_import(fullname) for fullname in fullnames]
 
 
 class LazyLoader(Loader):
@@ -182,14 +196,12 @@ def create_module(self, spec):
 
     def exec_module(self, module):
         """Make the module load lazily."""
-        module.__spec__.loader = self.loader
+        spec = module.__spec__
+        spec.loader = self.loader
         module.__loader__ = self.loader
-        # Don't need to worry about deep-copying as trying to set an attribute
-        # on an object would have triggered the load,
-        # e.g. ``module.__spec__.loader = None`` would trigger a load from
-        # trying to access module.__spec__.
+        # The module is executed by self.loader on the first attribute
+        # access, which waits for other threads loading it at the same time.
         loader_state = {}
-        loader_state['__dict__'] = module.__dict__.copy()
         loader_state['__class__'] = module.__class__
-        module.__spec__.loader_state = loader_state
-        module.__class__ = _LazyModule
+        loader_state['__dict__'] = _imp.module_set_lazy(module)
+        spec.loader_state = loader_state
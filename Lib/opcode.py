@@ -352,6 +352,9 @@ def pseudo_op(name, op, real_ops):
         "LOAD_GLOBAL_BUILTIN",
         "LOAD_GLOBAL_MODULE",
     ],
+    "RESUME": [
+        "RESUME_QUICKEN",
+    ],
     "STORE_ATTR": [
         "STORE_ATTR_GENERIC",
         "STORE_ATTR_INSTANCE_VALUE",
@@ -87,6 +87,11 @@
 USER_SITE = None
 USER_BASE = None
 
+# The modules that may provide the finders used while caching the results of
+# imports made by this module.
+_STANDARD_IMPORTERS = ('_frozen_importlib', '_frozen_importlib_external',
+                       'zipimport')
+
 
 def _trace(message):
     if sys.flags.verbose:
@@ -536,11 +541,78 @@ def venv(known_paths):
     return known_paths
 
 
+def _get_startup_cache():
+    """Return the cache of import results used by execsitecustomize() and
+    execusercustomize() and the stamp of sys.path to use with it.
+
+    (None, None) is returned if PYTHONSTARTUPCACHE is not set or if the
+    cache cannot be used for the current sys.path.
+    """
+    if sys.flags.ignore_environment:
+        return None, None
+    cache_dir = os.environ.get("PYTHONSTARTUPCACHE")
+    if not cache_dir:
+        return None, None
+    # Finders installed by .pth files may find modules anywhere
+    for importer in sys.meta_path + sys.path_hooks:
+        if getattr(importer, '__module__', None) not in _STANDARD_IMPORTERS:
+            return None, None
+    # A module added to or removed from a directory changes its mtime.
+    # Entries that do not exist yet are stamped with the mtime of their
+    # nearest existing parent directory.
+    stamp = 0
+    try:
+        for entry in sys.path:
+            while True:
+                try:
+                    stamp = max(stamp, os.stat(entry).st_mtime)
+                    break
+                except FileNotFoundError:
+                    parent = os.path.dirname(entry)
+                    if not entry or parent == entry:
+                        return None, None
+                    entry = parent
+    except (OSError, TypeError, ValueError):
+        return None, None
+    from _frozen_importlib_external import _PathIndex
+    return _PathIndex(os.path.join(cache_dir, "site.cache")), stamp
+
+
+def _import_customize(name):
+    """Import the module 'name', or raise ImportError if it is missing.
+
+    If PYTHONSTARTUPCACHE is set, a failed lookup is remembered for as long
+    as sys.path and the mtimes of its entries stay the same, which saves
+    searching every sys.path entry at each startup.
+    """
+    import _imp
+    cache, stamp = None, None
+    if not _imp.is_builtin(name) and not _imp.is_frozen(name):
+        cache, stamp = _get_startup_cache()
+    if cache is None:
+        __import__(name)
+        return
+
+    def find(key):
+        try:
+            __import__(name)
+        except ImportError as exc:
+            if exc.name == name:
+                return True
+            raise
+        return False
+
+    if cache.get((name, tuple(sys.path)), stamp, find):
+        raise ImportError(f"No module named {name!r}", name=name)
+    if name not in sys.modules:
+        __import__(name)
+
+
 def execsitecustomize():
     """Run custom site specific code, if available."""
     try:
         try:
-            import sitecustomize
+            _import_customize('sitecustomize')
         except ImportError as exc:
             if exc.name == 'sitecustomize':
                 pass
@@ -560,7 +632,7 @@ def execusercustomize():
     """Run custom user specific code, if available."""
     try:
         try:
-            import usercustomize
+            _import_customize('usercustomize')
         except ImportError as exc:
             if exc.name == 'usercustomize':
                 pass
@@ -4,6 +4,7 @@
 import enum
 import os
 import sys
+import threading
 import types
 import unittest
 import warnings
@@ -11,6 +12,7 @@
 from textwrap import dedent
 
 from test import support
+from test.support import threading_helper
 
 def to_tuple(t):
     if t is None or isinstance(t, (str, int, complex)) or t is Ellipsis:
@@ -843,6 +845,24 @@ def test_null_bytes(self):
             msg="source code string cannot contain null bytes"):
             ast.parse("a\0b")
 
+    @threading_helper.requires_working_threading()
+    def test_parse_in_threads(self):
+        # Converting the AST to Python objects must not share any state
+        # between threads.
+        source = "\n".join(f"def f{i}(a, b):\n    return [(a, b)] * {i}"
+                           for i in range(200))
+        expected = ast.dump(ast.parse(source))
+        results = []
+
+        def parse():
+            for _ in range(10):
+                results.append(ast.dump(ast.parse(source)))
+
+        threads = [threading.Thread(target=parse) for _ in range(4)]
+        with threading_helper.start_threads(threads):
+            pass
+        self.assertEqual(results, [expected] * 40)
+
 class ASTHelpers_Test(unittest.TestCase):
     maxDiff = None
 
@@ -35,6 +35,50 @@ def fn(**kw):
         self.assertIsInstance(res, dict)
         self.assertEqual(list(res.items()), expected)
 
+    def test_kwargs_forwarding(self):
+        # A function's own **kwargs is passed on without being copied
+        def fn(*args, **kw):
+            kw['added'] = True
+            return args, kw
+
+        class C:
+            def __init__(self, *args, **kw):
+                self.args = args
+                self.kw = kw
+
+        def wrapper(func, *args, **kwargs):
+            res = func(*args, **kwargs)
+            return res, kwargs
+
+        res, kwargs = wrapper(fn, 1, 2, a=3)
+        self.assertEqual(res, ((1, 2), {'a': 3, 'added': True}))
+        self.assertEqual(kwargs, {'a': 3})
+        res, kwargs = wrapper(dict, b=4)
+        self.assertEqual(res, {'b': 4})
+        self.assertIsNot(res, kwargs)
+        res, kwargs = wrapper(C, 5, c=6)
+        self.assertEqual((res.args, res.kw), ((5,), {'c': 6}))
+        self.assertIsNot(res.kw, kwargs)
+        with self.assertRaises(TypeError):
+            wrapper(fn, **{'x': 1, 'func': 2})
+
+    @cpython_only
+    def test_kwargs_forwarding_skips_copy(self):
+        import dis
+
+        def wrapper(*args, **kwargs):
+            return f(*args, **kwargs)
+
+        def rebinds(*args, **kwargs):
+            kwargs = dict(kwargs)
+            return f(*args, **kwargs)
+
+        ops = [i.opname for i in dis.get_instructions(wrapper)]
+        self.assertNotIn('DICT_MERGE', ops)
+        self.assertIn('CALL_FUNCTION_EX', ops)
+        ops = [i.opname for i in dis.get_instructions(rebinds)]
+        self.assertIn('DICT_MERGE', ops)
+
     def test_frames_are_popped_after_failed_calls(self):
         # GH-93252: stuff blows up if we don't pop the new frame after
         # recovering from failed calls:
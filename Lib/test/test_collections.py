@@ -11,13 +11,17 @@
 import string
 import sys
 from test import support
+from test.support import threading_helper
+import threading
 import types
 import unittest
+import weakref
 
 from collections import namedtuple, Counter, OrderedDict, _count_elements
 from collections import UserDict, UserString, UserList
 from collections import ChainMap
 from collections import deque
+from collections import ConcurrentDict
 from collections.abc import Awaitable, Coroutine
 from collections.abc import AsyncIterator, AsyncIterable, AsyncGenerator
 from collections.abc import Hashable, Iterable, Iterator, Generator, Reversible
@@ -2382,6 +2386,185 @@ def test_gt(self):
         self.assertFalse(Counter(a=2, b=1, c=0) > Counter('aab'))
 
 
+################################################################################
+### ConcurrentDict
+################################################################################
+
+class TestConcurrentDict(unittest.TestCase):
+
+    def test_basics(self):
+        d = ConcurrentDict()
+        self.assertEqual(len(d), 0)
+        d['a'] = 1
+        d[2] = 'b'
+        self.assertEqual(len(d), 2)
+        self.assertEqual(d['a'], 1)
+        self.assertEqual(d[2], 'b')
+        self.assertIn('a', d)
+        self.assertNotIn('c', d)
+        self.assertRaises(KeyError, d.__getitem__, 'c')
+        del d['a']
+        self.assertNotIn('a', d)
+        self.assertRaises(KeyError, d.__delitem__, 'a')
+        self.assertRaises(TypeError, d.__setitem__, [], 1)
+        self.assertRaises(TypeError, d.__getitem__, [])
+        self.assertRaises(TypeError, hash, d)
+
+    def test_constructor(self):
+        self.assertEqual(ConcurrentDict(), {})
+        self.assertEqual(ConcurrentDict({1: 2}, a=3), {1: 2, 'a': 3})
+        self.assertEqual(ConcurrentDict([(1, 2), (3, 4)]), {1: 2, 3: 4})
+        self.assertEqual(ConcurrentDict(ConcurrentDict(x=1)), {'x': 1})
+        self.assertRaises(TypeError, ConcurrentDict, 1)
+        self.assertRaises(TypeError, ConcurrentDict, {}, {})
+
+    def test_methods(self):
+        d = ConcurrentDict(a=1)
+        self.assertEqual(d.get('a'), 1)
+        self.assertIsNone(d.get('b'))
+        self.assertEqual(d.get('b', 2), 2)
+        self.assertEqual(d.setdefault('a', 5), 1)
+        self.assertEqual(d.setdefault('b', 5), 5)
+        self.assertIsNone(d.setdefault('c'))
+        self.assertEqual(d.pop('c'), None)
+        self.assertEqual(d.pop('c', 7), 7)
+        self.assertRaises(KeyError, d.pop, 'c')
+        d.update({'x': 1}, y=2)
+        d.update([('z', 3)])
+        self.assertEqual(sorted(d.keys()), ['a', 'b', 'x', 'y', 'z'])
+        self.assertEqual(sorted(d.values()), [1, 1, 2, 3, 5])
+        self.assertEqual(sorted(d.items()),
+                         [('a', 1), ('b', 5), ('x', 1), ('y', 2), ('z', 3)])
+        self.assertEqual(sorted(d), sorted(d.keys()))
+        d.clear()
+        self.assertEqual(len(d), 0)
+        self.assertEqual(list(d), [])
+
+    def test_many_keys(self):
+        d = ConcurrentDict()
+        n = 10000
+        for i in range(n):
+            d[i] = str(i)
+        self.assertEqual(len(d), n)
+        self.assertEqual(sorted(d), list(range(n)))
+        for i in range(0, n, 2):
+            del d[i]
+        self.assertEqual(len(d), n // 2)
+        self.assertEqual(d, {i: str(i) for i in range(1, n, 2)})
+
+    def test_comparison(self):
+        d = ConcurrentDict(a=1, b=2)
+        self.assertEqual(d, {'a': 1, 'b': 2})
+        self.assertEqual({'a': 1, 'b': 2}, d)
+        self.assertEqual(d, ConcurrentDict(b=2, a=1))
+        self.assertNotEqual(d, {'a': 1})
+        self.assertNotEqual(d, [('a', 1), ('b', 2)])
+        self.assertRaises(TypeError, operator.lt, d, d)
+
+    def test_copy_and_pickle(self):
+        d = ConcurrentDict({1: [2]}, a='b')
+        for dup in (d.copy(), copy.copy(d)):
+            self.assertIs(type(dup), ConcurrentDict)
+            self.assertEqual(dup, d)
+            self.assertIs(dup[1], d[1])
+        dup = copy.deepcopy(d)
+        self.assertEqual(dup, d)
+        self.assertIsNot(dup[1], d[1])
+        for proto in range(pickle.HIGHEST_PROTOCOL + 1):
+            dup = pickle.loads(pickle.dumps(d, proto))
+            self.assertIs(type(dup), ConcurrentDict)
+            self.assertEqual(dup, d)
+
+    def test_repr(self):
+        self.assertEqual(repr(ConcurrentDict()), 'ConcurrentDict({})')
+        self.assertEqual(repr(ConcurrentDict(a=1)), "ConcurrentDict({'a': 1})")
+        d = ConcurrentDict()
+        d['self'] = d
+        self.assertEqual(repr(d), "ConcurrentDict({'self': ...})")
+
+    def test_abc(self):
+        self.assertIsInstance(ConcurrentDict(), MutableMapping)
+        self.assertTrue(issubclass(ConcurrentDict, MutableMapping))
+        d = ConcurrentDict(a=1)
+        self.assertEqual(d.popitem(), ('a', 1))
+        self.assertEqual(len(d), 0)
+
+    def test_subclass(self):
+        class Sub(ConcurrentDict):
+            pass
+        d = Sub(a=1)
+        self.assertEqual(d['a'], 1)
+        self.assertIs(type(d.copy()), Sub)
+        self.assertEqual(repr(d), "Sub({'a': 1})")
+
+    def test_gc(self):
+        d = ConcurrentDict()
+        d['self'] = d
+        wr = weakref.ref(d)
+        del d
+        support.gc_collect()
+        self.assertIsNone(wr())
+
+    @threading_helper.requires_working_threading()
+    def test_threads(self):
+        d = ConcurrentDict()
+        nthreads = 8
+        n = 2000
+        def worker(t):
+            for i in range(n):
+                d[t, i] = i
+                self.assertEqual(d[t, i], i)
+                d.setdefault(('shared', i), t)
+            for i in range(0, n, 2):
+                del d[t, i]
+        threads = [threading.Thread(target=worker, args=(t,))
+                   for t in range(nthreads)]
+        with threading_helper.start_threads(threads):
+            pass
+        self.assertEqual(len(d), nthreads * n // 2 + n)
+        for t in range(nthreads):
+            for i in range(1, n, 2):
+                self.assertEqual(d[t, i], i)
+
+    @threading_helper.requires_working_threading()
+    def test_threads_stress(self):
+        # Threads insert interleaved runs of consecutive ints, so nearby
+        # keys are written concurrently, while they look up and replace
+        # each other's keys and all of them grow the segments.
+        d = ConcurrentDict()
+        nthreads = 8
+        n = 5000
+        barrier = threading.Barrier(nthreads)
+        errors = []
+        def worker(t):
+            barrier.wait()
+            for i in range(t + 1, n * nthreads + 1, nthreads):
+                d[i] = i
+                if d.get(i) != i:
+                    errors.append((t, i))
+                other = i - 1
+                value = d.get(other)
+                if value is not None and value != other:
+                    errors.append((t, other, value))
+                d.setdefault(-i, t)
+            for i in range(t + 1, n * nthreads + 1, nthreads * 2):
+                if d.pop(i) != i:
+                    errors.append((t, i))
+        threads = [threading.Thread(target=worker, args=(t,))
+                   for t in range(nthreads)]
+        with threading_helper.start_threads(threads):
+            pass
+        self.assertEqual(errors, [])
+        keys = range(1, n * nthreads + 1)
+        removed = {i for t in range(nthreads)
+                   for i in range(t + 1, n * nthreads + 1, nthreads * 2)}
+        expected = {i: i for i in keys if i not in removed}
+        expected.update({-i: (i - 1) % nthreads for i in keys})
+        self.assertEqual(len(d), len(expected))
+        self.assertEqual(d, expected)
+
+
+
 def load_tests(loader, tests, pattern):
     tests.addTest(doctest.DocTestSuite(collections))
     return tests
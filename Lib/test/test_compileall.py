@@ -25,6 +25,13 @@
 except (NotImplementedError, ModuleNotFoundError):
     _have_multiprocessing = False
 
+class _GILFlags:
+    # sys.flags of a build with the GIL: compileall uses processes.
+    nogil = False
+
+    def __getattr__(self, name, *, _flags=sys.flags):
+        return getattr(_flags, name)
+
 from test import support
 from test.support import os_helper
 from test.support import script_helper
@@ -248,6 +255,7 @@ def test_compile_dir_pathlike_prependdir(self):
         self.assertTrue(os.path.isfile(self.bc_path))
 
     @skipUnless(_have_multiprocessing, "requires multiprocessing")
+    @mock.patch('sys.flags', _GILFlags())
     @mock.patch('concurrent.futures.ProcessPoolExecutor')
     def test_compile_pool_called(self, pool_mock):
         compileall.compile_dir(self.directory, quiet=True, workers=5)
@@ -259,12 +267,14 @@ def test_compile_workers_non_positive(self):
             compileall.compile_dir(self.directory, workers=-1)
 
     @skipUnless(_have_multiprocessing, "requires multiprocessing")
+    @mock.patch('sys.flags', _GILFlags())
     @mock.patch('concurrent.futures.ProcessPoolExecutor')
     def test_compile_workers_cpu_count(self, pool_mock):
         compileall.compile_dir(self.directory, quiet=True, workers=0)
         self.assertEqual(pool_mock.call_args[1]['max_workers'], None)
 
     @skipUnless(_have_multiprocessing, "requires multiprocessing")
+    @mock.patch('sys.flags', _GILFlags())
     @mock.patch('concurrent.futures.ProcessPoolExecutor')
     @mock.patch('compileall.compile_file')
     def test_compile_one_worker(self, compile_file_mock, pool_mock):
@@ -273,12 +283,41 @@ def test_compile_one_worker(self, compile_file_mock, pool_mock):
         self.assertTrue(compile_file_mock.called)
 
     @skipUnless(_have_multiprocessing, "requires multiprocessing")
+    @mock.patch('sys.flags', _GILFlags())
     @mock.patch('concurrent.futures.ProcessPoolExecutor', new=None)
     @mock.patch('compileall.compile_file')
     def test_compile_missing_multiprocessing(self, compile_file_mock):
         compileall.compile_dir(self.directory, quiet=True, workers=5)
         self.assertTrue(compile_file_mock.called)
 
+    @skipUnless(sys.flags.nogil, "requires the GIL to be disabled")
+    @mock.patch('concurrent.futures.ProcessPoolExecutor')
+    @mock.patch('concurrent.futures.ThreadPoolExecutor')
+    def test_compile_thread_pool_called(self, pool_mock, process_pool_mock):
+        compileall.compile_dir(self.directory, quiet=True, workers=5)
+        self.assertEqual(pool_mock.call_args[1]['max_workers'], 5)
+        self.assertFalse(process_pool_mock.called)
+
+    @skipUnless(sys.flags.nogil, "requires the GIL to be disabled")
+    @mock.patch('os.cpu_count', return_value=3)
+    @mock.patch('concurrent.futures.ThreadPoolExecutor')
+    def test_compile_threads_cpu_count(self, pool_mock, cpu_count_mock):
+        compileall.compile_dir(self.directory, quiet=True, workers=0)
+        self.assertEqual(pool_mock.call_args[1]['max_workers'], 3)
+
+    @skipUnless(sys.flags.nogil, "requires the GIL to be disabled")
+    def test_compile_threads(self):
+        for i in range(20):
+            script_helper.make_script(self.directory, f'mod{i}', 'x = 1\n')
+        script_helper.make_script(self.directory, 'bad', 'x = (\n')
+        with support.captured_stdout():
+            self.assertFalse(compileall.compile_dir(self.directory,
+                                                    quiet=1, workers=4))
+        for i in range(20):
+            self.assertTrue(os.path.isfile(importlib.util.cache_from_source(
+                os.path.join(self.directory, f'mod{i}.py'))))
+        self.assertTrue(os.path.isfile(self.bc_path))
+
     def test_compile_dir_maxlevels(self):
         # Test the actual impact of maxlevels parameter
         depth = 3
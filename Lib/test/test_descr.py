@@ -4719,6 +4719,28 @@ def __getattribute__(self, name):
 
         self.assertRaises(AttributeError, getattr, EvilGetattribute(), "attr")
 
+    def test_getattr_fallback(self):
+        # __getattr__ is called for any AttributeError from the default
+        # __getattribute__, but other exceptions propagate.
+        class D:
+            @property
+            def missing(self):
+                raise AttributeError('missing')
+            @property
+            def broken(self):
+                raise ValueError('broken')
+            def __getattr__(self, name):
+                self.seen = (name, sys.exc_info()[1])
+                return name
+
+        d = D()
+        self.assertEqual(d.attr, 'attr')
+        self.assertEqual(d.seen, ('attr', None))
+        self.assertEqual(d.missing, 'missing')
+        self.assertEqual(getattr(d, 'other', None), 'other')
+        self.assertTrue(hasattr(d, 'x'))
+        self.assertRaises(ValueError, getattr, d, 'broken')
+
     def test_type___getattribute__(self):
         self.assertRaises(TypeError, type.__getattribute__, list, type)
 
@@ -790,6 +790,28 @@ def test_tuple_keyerror(self):
             d[(1,)]
         self.assertEqual(c.exception.args, ((1,),))
 
+    def test_keyerror_args(self):
+        # The exception is built lazily for some key types; the
+        # arguments must not depend on that.
+        d = {}
+        for key in ('a', 1, 2**100, None, (), True, 1.5, KeyError('x')):
+            with self.subTest(key=key):
+                with self.assertRaises(KeyError) as c:
+                    d[key]
+                self.assertEqual(c.exception.args, (key,))
+                with self.assertRaises(KeyError) as c:
+                    d.pop(key)
+                self.assertEqual(c.exception.args, (key,))
+                # Raised while another exception is being handled
+                try:
+                    try:
+                        raise ValueError
+                    except ValueError:
+                        d[key]
+                except KeyError as e:
+                    self.assertEqual(e.args, (key,))
+                    self.assertIsInstance(e.__context__, ValueError)
+
     def test_bad_key(self):
         # Dictionary lookups should fail if __eq__() raises an exception.
         class CustomException(Exception):
@@ -856,6 +878,115 @@ def __eq__(self, other):
         resizing = True
         d[9] = 6
 
+    def check_incremental_resize(self, keys):
+        # Large tables are grown incrementally: the entries move to the new
+        # table over the following updates.  Every operation must see them
+        # wherever they currently are.
+        d = {}
+        for i, k in enumerate(keys):
+            d[k] = i
+            if i % 997 == 0:
+                self.assertEqual(d[keys[i // 2]], i // 2)
+                self.assertIn(keys[i // 3], d)
+                self.assertNotIn(-1, d)
+        self.assertEqual(len(d), len(keys))
+        self.assertEqual(list(d), keys)
+        self.assertEqual(list(reversed(d)), keys[::-1])
+        self.assertEqual(list(d.values()), list(range(len(keys))))
+        self.assertEqual(d, dict(zip(keys, range(len(keys)))))
+        self.assertEqual(d.copy(), d)
+
+        # Grow once more, then update, delete and pop while entries are
+        # still being moved.
+        n = len(keys)
+        more = [k + n if isinstance(k, int) else k + 'x' for k in keys]
+        for i, k in enumerate(more):
+            d[k] = i
+            if i % 3 == 0:
+                d[keys[i]] = -i
+            elif i % 3 == 1:
+                del d[keys[i]]
+            else:
+                self.assertEqual(d.pop(keys[i]), i)
+        self.assertEqual(len(d), n + (n + 2) // 3)
+        for i, k in enumerate(keys):
+            self.assertEqual(d.get(k), -i if i % 3 == 0 else None)
+        self.assertEqual(list(d)[-n:], more)
+        key, value = d.popitem()
+        self.assertNotIn(key, d)
+        d2 = {}
+        d2.update(d)
+        self.assertEqual(d2, d)
+        self.assertEqual(sorted(d.items(), key=repr),
+                         sorted(dict(d.items()).items(), key=repr))
+        d.clear()
+        self.assertEqual(d, {})
+
+    def test_incremental_resize_int_keys(self):
+        self.check_incremental_resize(list(range(100_000)))
+
+    def test_incremental_resize_str_keys(self):
+        self.check_incremental_resize([str(i) for i in range(100_000)])
+
+    def test_large_dict_colliding_hashes(self):
+        # Large tables tag their index slots with high bits of the hash.
+        # Keys whose hashes agree on the low bits must still be told apart,
+        # and keys whose hashes are equal must still be compared.
+        class Key:
+            def __init__(self, value, hash):
+                self.value = value
+                self.hash = hash
+            def __hash__(self):
+                return self.hash
+            def __eq__(self, other):
+                return isinstance(other, Key) and self.value == other.value
+
+        n = 50_000
+        d = dict.fromkeys(range(n))
+        low = [i << 20 for i in range(1, 200)]
+        same = [Key(i, 12345) for i in range(200)]
+        for k in low + same:
+            d[k] = k
+        for k in low + same:
+            self.assertIs(d[k], k)
+        self.assertNotIn(200 << 20, d)
+        self.assertNotIn(Key(200, 12345), d)
+        for k in low[::2] + same[::2]:
+            del d[k]
+        for k in low[1::2] + same[1::2]:
+            self.assertIs(d.pop(k), k)
+        self.assertEqual(len(d), n)
+        self.assertEqual(d.popitem(), (n - 1, None))
+
+    def test_incremental_resize_gc(self):
+        # Values that were not moved yet are still traversed.
+        class A:
+            pass
+        d = {i: A() for i in range(100_000)}
+        d[-1] = d
+        refs = [weakref.ref(d[i]) for i in range(0, 100_000, 1000)]
+        self.assertTrue(gc.is_tracked(d))
+        del d
+        gc.collect()
+        self.assertTrue(all(r() is None for r in refs))
+
+    def test_incremental_resize_read_only(self):
+        # A pending resize also advances on lookups and iteration, so the
+        # old table is released even if the dict is never updated again.
+        n = 174_763     # one more than fits in a table of 2**18 slots
+        for keys in (range(n), [str(i) for i in range(n)]):
+            for finish in (lambda d: [d[k] for k in keys[:n // 32]],
+                           lambda d: list(d)):
+                d = dict.fromkeys(keys[:n - 1])
+                before = sys.getsizeof(d)
+                d[keys[-1]] = None
+                grown = sys.getsizeof(d)
+                self.assertGreater(grown, before)
+                finish(d)
+                self.assertLess(sys.getsizeof(d), grown)
+                self.assertEqual(len(d), n)
+                self.assertIn(keys[-1], d)
+
     def test_empty_presized_dict_in_freelist(self):
         # Bug #3537: if an empty but presized dict with a size larger
         # than 7 was in the freelist, it triggered an assertion failure
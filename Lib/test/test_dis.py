@@ -8,6 +8,7 @@
 import types
 import unittest
 from test.support import captured_stdout, requires_debug_ranges, cpython_only
+from test.support import threading_helper
 from test.support.bytecode_helper import BytecodeTestCase
 
 import opcode
@@ -1091,6 +1092,47 @@ def test_super_instructions(self):
         got = self.get_disassembly(load_test, adaptive=True)
         self.do_disassembly_compare(got, dis_load_test_quickened_code, True)
 
+    @cpython_only
+    def test_quicken_on_first_call(self):
+        def f(a, b):
+            x = a
+            return x + b
+        def opnames():
+            return [i.opname for i in dis.get_instructions(f, adaptive=True)]
+        # Code is only quickened once it starts running:
+        self.assertEqual(opnames()[0], "RESUME_QUICKEN")
+        self.assertNotIn("STORE_FAST__LOAD_FAST", opnames())
+        self.assertEqual(dis.get_instructions(f).__next__().opname, "RESUME")
+        self.assertEqual(f(1, 2), 3)
+        self.assertEqual(opnames()[0], "RESUME")
+        self.assertIn("STORE_FAST__LOAD_FAST", opnames())
+
+    @cpython_only
+    @threading_helper.requires_working_threading()
+    def test_quicken_on_first_call_threads(self):
+        import threading
+        nthreads = 4
+        for _ in range(50):
+            def f(n):
+                total = 0
+                for i in range(n):
+                    x = i
+                    total += x
+                return total
+            barrier = threading.Barrier(nthreads)
+            results = []
+            def run():
+                barrier.wait()
+                results.append(f(100))
+            threads = [threading.Thread(target=run) for _ in range(nthreads)]
+            with threading_helper.start_threads(threads):
+                pass
+            self.assertEqual(results, [4950] * nthreads)
+            opnames = [i.opname
+                       for i in dis.get_instructions(f, adaptive=True)]
+            self.assertEqual(opnames[0], "RESUME")
+            self.assertIn("STORE_FAST__LOAD_FAST", opnames)
+
     @cpython_only
     def test_binary_specialize(self):
         binary_op_quicken = """\
@@ -363,6 +363,8 @@ def is_specialized(f):
                         # Exclude superinstructions:
                         and "__" not in opname
                         and not opname.endswith("_PROFILE")
+                        # Exclude the not-yet-quickened marker:
+                        and opname != "RESUME_QUICKEN"
                     ):
                         return True
                 return False
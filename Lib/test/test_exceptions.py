@@ -616,6 +616,24 @@ class MyException(Exception):
         self.assertIsInstance(e, MyException)
         self.assertEqual(e.__traceback__, tb)
 
+    def test_traceback_lineno(self):
+        # tb_lineno is computed from tb_lasti, not from the frame's
+        # current line, so it stays put once the frame moves on.
+        def raiser():
+            raise KeyError(1)
+        first = sys._getframe().f_lineno + 2
+        try:
+            raiser()
+        except KeyError as e:
+            tb = e.__traceback__
+        self.assertEqual(tb.tb_lineno, first)
+        self.assertEqual(tb.tb_next.tb_lineno,
+                         raiser.__code__.co_firstlineno + 1)
+        self.assertIsNone(tb.tb_next.tb_next)
+
+        tb = type(tb)(None, sys._getframe(), 0, 42)
+        self.assertEqual(tb.tb_lineno, 42)
+
     def testInvalidTraceback(self):
         try:
             Exception().__traceback__ = 5
@@ -88,6 +88,35 @@ def gen():
         self.assertTrue(finalized)
         self.assertEqual(gc.garbage, old_garbage)
 
+    def test_finalize_reused_objects(self):
+        # Freed generators and coroutines may be recycled for new ones;
+        # each new object must still be finalized and start out fresh.
+        closed = []
+        def gen(i):
+            try:
+                yield i
+            finally:
+                closed.append(i)
+        async def coro(i):
+            try:
+                await Awaitable()
+            finally:
+                closed.append(i)
+        class Awaitable:
+            def __await__(self):
+                yield
+
+        for i in range(50):
+            obj = gen(i) if i % 2 else coro(i)
+            self.assertEqual(type(obj).__name__,
+                             'generator' if i % 2 else 'coroutine')
+            self.assertEqual(obj.__name__, 'gen' if i % 2 else 'coro')
+            wr = weakref.ref(obj)
+            obj.send(None)
+            del obj
+            self.assertIsNone(wr())
+        self.assertEqual(closed, list(range(50)))
+
     def test_lambda_generator(self):
         # Issue #23192: Test that a lambda returning a generator behaves
         # like the equivalent function
@@ -2,14 +2,18 @@
 
 machinery = util.import_importlib('importlib.machinery')
 
+import atexit
 import errno
+import marshal
 import os
 import py_compile
 import stat
 import sys
 import tempfile
 from test.support.import_helper import make_legacy_pyc
+from test.support.script_helper import assert_python_ok
 import unittest
+from unittest import mock
 import warnings
 
 
@@ -142,6 +146,15 @@ def test_invalidate_caches(self):
         finder.invalidate_caches()
         self.assertEqual(finder._path_mtime, -1)
 
+    def test_deleted_cwd(self):
+        # A cwd that no longer exists lists as empty.
+        finder = self.machinery.FileFinder('', (self.machinery.SourceFileLoader,
+            self.machinery.SOURCE_SUFFIXES))
+        _os = finder._fill_cache.__globals__['_os']
+        with mock.patch.object(_os, 'getcwd', side_effect=FileNotFoundError):
+            finder._fill_cache()
+        self.assertEqual(finder._path_cache, set())
+
     # Regression test for http://bugs.python.org/issue14846
     def test_dir_removal_handling(self):
         mod = 'mod'
@@ -222,5 +235,94 @@ def _find(self, finder, name, loader_only=False):
  ) = util.test_both(FinderTestsPEP302, machinery=machinery)
 
 
+class PathIndexTests(unittest.TestCase):
+
+    def setUp(self):
+        from importlib import _bootstrap_external
+        self.bootstrap = _bootstrap_external
+        tempdir = tempfile.TemporaryDirectory()
+        self.enterContext(tempdir)
+        self.root = os.path.join(tempdir.name, 'path')
+        os.mkdir(self.root)
+        with open(os.path.join(self.root, 'mod.py'), 'w', encoding='utf-8'):
+            pass
+        # Keep the directory out of the clock tick the index is written in.
+        os.utime(self.root, (1000, 1000))
+        self.mtime = os.stat(self.root).st_mtime
+        self.filename = os.path.join(tempdir.name, 'index')
+
+    def make_index(self):
+        index = self.bootstrap._PathIndex(self.filename)
+        self.addCleanup(atexit.unregister, index.save)
+        return index
+
+    def test_listdir(self):
+        index = self.make_index()
+        self.assertEqual(index.listdir(self.root, self.mtime), ('mod.py',))
+        self.assertFalse(os.path.exists(self.filename))
+        index.save()
+        index = self.make_index()
+        with mock.patch.object(self.bootstrap._os, 'listdir',
+                               side_effect=AssertionError):
+            self.assertEqual(index.listdir(self.root, self.mtime), ('mod.py',))
+
+    def test_stale(self):
+        index = self.make_index()
+        index.listdir(self.root, self.mtime)
+        index.save()
+        with open(os.path.join(self.root, 'mod2.py'), 'w', encoding='utf-8'):
+            pass
+        os.utime(self.root, (2000, 2000))
+        mtime = os.stat(self.root).st_mtime
+        index = self.make_index()
+        self.assertEqual(sorted(index.listdir(self.root, mtime)),
+                         ['mod.py', 'mod2.py'])
+
+    def test_racy(self):
+        # Listings made in the clock tick the index was written in are not
+        # trusted.
+        index = self.make_index()
+        index.listdir(self.root, 1e12)
+        index.save()
+        index = self.make_index()
+        with mock.patch.object(self.bootstrap._os, 'listdir',
+                               return_value=['other.py']):
+            self.assertEqual(index.listdir(self.root, 1e12), ('other.py',))
+
+    def test_merge(self):
+        other = os.path.join(os.path.dirname(self.root), 'other')
+        os.mkdir(other)
+        os.utime(other, (1000, 1000))
+        index1 = self.make_index()
+        index2 = self.make_index()
+        index1.listdir(self.root, self.mtime)
+        index2.listdir(other, os.stat(other).st_mtime)
+        index1.save()
+        index2.save()
+        with open(self.filename, 'rb') as file:
+            magic, entries = marshal.load(file)
+        self.assertEqual(sorted(entries), sorted([self.root, other]))
+
+    def test_corrupt(self):
+        with open(self.filename, 'wb') as file:
+            file.write(b'garbage')
+        index = self.make_index()
+        self.assertEqual(index.listdir(self.root, self.mtime), ('mod.py',))
+        index.save()
+        with open(self.filename, 'rb') as file:
+            magic, entries = marshal.load(file)
+        self.assertEqual(entries, {self.root: (self.mtime, ('mod.py',))})
+
+    def test_environment(self):
+        assert_python_ok('-c', 'import mod', PYTHONPATH=self.root,
+                         PYTHONPATHINDEX=self.filename)
+        with open(self.filename, 'rb') as file:
+            magic, entries = marshal.load(file)
+        self.assertEqual(entries[self.root], (self.mtime, ('mod.py',)))
+        os.unlink(self.filename)
+        assert_python_ok('-E', '-c', 'import sys', PYTHONPATHINDEX=self.filename)
+        self.assertFalse(os.path.exists(self.filename))
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -2,9 +2,12 @@
 from importlib import abc
 from importlib import util
 import sys
+import threading
+import time
 import types
 import unittest
 
+from test.support import threading_helper
 from test.test_importlib import util as test_util
 
 
@@ -50,6 +53,7 @@ def find_spec(self, name, path, target=None):
     def exec_module(self, module):
         exec(self.source_code, module.__dict__)
         self.loaded = module
+        self.load_count = getattr(self, 'load_count', 0) + 1
 
 
 class LazyLoaderTests(unittest.TestCase):
@@ -140,6 +144,96 @@ def test_module_already_in_sys(self):
             # Force the load; just care that no exception is raised.
             module.__name__
 
+    def test_module_type(self):
+        # The module stays a plain module, before and after the load.
+        module = self.new_module()
+        self.assertIs(type(module), types.ModuleType)
+        self.assertEqual(42, module.attr)
+        self.assertIs(type(module), types.ModuleType)
+
+    def test_loader_state(self):
+        # loader_state holds the module dict and class from before the load.
+        module = self.new_module()
+        module.new_attr = 1
+        loader_state = module.__spec__.loader_state
+        self.assertIs(loader_state['__class__'], types.ModuleType)
+        self.assertEqual(loader_state['__dict__']['__name__'],
+                         TestingImporter.module_name)
+        self.assertNotIn('new_attr', loader_state['__dict__'])
+        self.assertNotIn('attr', loader_state['__dict__'])
+
+    def test_load_once(self):
+        module = self.new_module()
+        module.attr
+        module.attr
+        self.assertEqual(module.__loader__.load_count, 1)
+
+    def test_load_error(self):
+        # An error raised by the module is propagated and the module is not
+        # loaded again.
+        module = self.new_module('attr = 1; 1/0')
+        with self.assertRaises(ZeroDivisionError):
+            module.attr
+        self.assertEqual(module.attr, 1)
+
+    def test_not_module(self):
+        spec = util.spec_from_loader('lazy_loader_test',
+                                     util.LazyLoader(TestingImporter()))
+        with self.assertRaises(TypeError):
+            spec.loader.exec_module(types.SimpleNamespace(__spec__=spec))
+
+    @threading_helper.requires_working_threading()
+    def test_threads(self):
+        # The module is executed once, and threads accessing its attributes
+        # during the load wait for it to complete.
+        module = self.new_module('import time; time.sleep(0.1); attr = 42')
+        results = []
+        def access():
+            results.append(module.attr)
+        threads = [threading.Thread(target=access) for _ in range(10)]
+        with threading_helper.start_threads(threads):
+            pass
+        self.assertEqual(results, [42] * 10)
+        self.assertEqual(module.__loader__.load_count, 1)
+
+    @threading_helper.requires_working_threading()
+    def test_threads_circular_import(self):
+        # The lazy module imports a module that another thread is importing
+        # and that accesses the lazy module.  As for an eager circular
+        # import, the other thread sees the lazy module partially
+        # initialized instead of deadlocking.
+        other_name = 'lazy_loader_other'
+        loading = threading.get_ident()
+        in_lazy = threading.Event()
+        in_other = threading.Event()
+        results = []
+        module = self.new_module(f'in_lazy.set(); import {other_name}; '
+                                 'attr = 42')
+        module.in_lazy = in_lazy
+
+        class OtherImporter(abc.MetaPathFinder, abc.Loader):
+            def find_spec(self, name, path, target=None):
+                if name == other_name:
+                    return util.spec_from_loader(name, self)
+            def exec_module(self, other):
+                in_other.set()
+                in_lazy.wait()
+                # Wait for the lazy module to block on this import.
+                while loading not in importlib._bootstrap._blocking_on:
+                    time.sleep(0.01)
+                results.append(getattr(module, 'attr', None))
+
+        with test_util.uncache(other_name), \
+             test_util.import_state(meta_path=[OtherImporter(),
+                                               *sys.meta_path]):
+            thread = threading.Thread(target=importlib.import_module,
+                                      args=(other_name,))
+            with threading_helper.start_threads([thread]):
+                in_other.wait()
+                self.assertEqual(module.attr, 42)
+        self.assertEqual(results, [None])
+        self.assertEqual(module.__loader__.load_count, 1)
+
 
 if __name__ == '__main__':
     unittest.main()
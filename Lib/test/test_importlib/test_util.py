@@ -5,6 +5,8 @@
 machinery = util.import_importlib('importlib.machinery')
 importlib_util = util.import_importlib('importlib.util')
 
+import contextlib
+import importlib.machinery
 import importlib.util
 import os
 import pathlib
@@ -596,6 +598,54 @@ def test_source_from_cache_outside_pycache_prefix(self):
  ) = util.test_both(PEP3147Tests, util=importlib_util)
 
 
+class ImportParallelTests(unittest.TestCase):
+
+    @contextlib.contextmanager
+    def create_modules(self):
+        names = ['pkg.__init__', 'pkg.a', 'pkg.b', 'c', 'd']
+        with util.create_modules(*names) as mapping:
+            sys.meta_path.append(importlib.machinery.PathFinder)
+            loader = (importlib.machinery.SourceFileLoader,
+                      importlib.machinery.SOURCE_SUFFIXES)
+            sys.path_hooks.append(
+                importlib.machinery.FileFinder.path_hook(loader))
+            yield mapping
+
+    def test_import_parallel(self):
+        for max_workers in (None, 1, 2):
+            with self.subTest(max_workers=max_workers), \
+                 self.create_modules():
+                modules = importlib.util.import_parallel(
+                    ['c', '.a', 'd', '.b', 'c'], 'pkg',
+                    max_workers=max_workers)
+                self.assertEqual([m.__name__ for m in modules],
+                                 ['c', 'pkg.a', 'd', 'pkg.b', 'c'])
+                for module in modules:
+                    self.assertIs(sys.modules[module.__name__], module)
+                    self.assertEqual(module.attr, module.__name__)
+
+    def test_already_imported(self):
+        modules = importlib.util.import_parallel(['sys', 'os.path'])
+        self.assertEqual(modules, [sys, os.path])
+
+    def test_error(self):
+        for max_workers in (None, 1):
+            with self.subTest(max_workers=max_workers), \
+                 self.create_modules():
+                with self.assertRaises(ModuleNotFoundError) as cm:
+                    importlib.util.import_parallel(
+                        ['c', 'pkg.missing', 'missing', 'd'],
+                        max_workers=max_workers)
+                self.assertEqual(cm.exception.name, 'pkg.missing')
+                # The other modules were still imported.
+                self.assertIn('c', sys.modules)
+                self.assertIn('d', sys.modules)
+
+    def test_max_workers(self):
+        with self.assertRaises(ValueError):
+            importlib.util.import_parallel(['sys'], max_workers=0)
+
+
 class MagicNumberTests(unittest.TestCase):
     """
     Test release compatibility issues relating to importlib
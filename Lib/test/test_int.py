@@ -1,8 +1,8 @@
+import random
 import sys
 import time
 
 import unittest
-from unittest import mock
 from test import support
 from test.test_grammar import (VALID_UNDERSCORE_LITERALS,
                                INVALID_UNDERSCORE_LITERALS)
@@ -802,8 +802,8 @@ class IntSubclassStrDigitLimitsTests(IntStrDigitLimitsTests):
 
 
 class PyLongModuleTests(unittest.TestCase):
-    # Tests of the functions in _pylong.py.  Those get used when the
-    # number of digits in the input values are large enough.
+    # Tests of ints large enough for the subquadratic algorithms of
+    # longobject.c.  _pylong.py serves as an independent reference.
 
     def setUp(self):
         super().setUp()
@@ -847,39 +847,46 @@ def test_pylong_str_to_int(self):
         with self.assertRaises(ValueError) as err:
             int('_' + s)
 
-    @support.cpython_only  # tests implementation details of CPython.
     @unittest.skipUnless(_pylong, "_pylong module required")
-    @mock.patch.object(_pylong, "int_to_decimal_string")
-    def test_pylong_misbehavior_error_path_to_str(
-            self, mock_int_to_str):
-        with support.adjust_int_max_str_digits(20_000):
-            big_value = int('7'*19_999)
-            mock_int_to_str.return_value = None  # not a str
-            with self.assertRaises(TypeError) as ctx:
-                str(big_value)
-            self.assertIn('_pylong.int_to_decimal_string did not',
-                          str(ctx.exception))
-            mock_int_to_str.side_effect = RuntimeError("testABC")
-            with self.assertRaises(RuntimeError):
-                str(big_value)
-
-    @support.cpython_only  # tests implementation details of CPython.
-    @unittest.skipUnless(_pylong, "_pylong module required")
-    @mock.patch.object(_pylong, "int_from_string")
-    def test_pylong_misbehavior_error_path_from_str(
-            self, mock_int_from_str):
-        big_value = '7'*19_999
-        with support.adjust_int_max_str_digits(20_000):
-            mock_int_from_str.return_value = b'not an int'
-            with self.assertRaises(TypeError) as ctx:
-                int(big_value)
-            self.assertIn('_pylong.int_from_string did not',
-                          str(ctx.exception))
-
-            mock_int_from_str.side_effect = RuntimeError("test123")
-            with self.assertRaises(RuntimeError):
-                int(big_value)
-
+    def test_subquadratic_int_to_decimal(self):
+        # Sizes around the cutoffs of the divide-and-conquer conversion in
+        # longobject.c and around powers of its decimal base.
+        for bits in (1000, 1200, 3000, 7000, 30_000, 100_001):
+            for n in ((1 << bits) - 1, 1 << bits, 10**(bits // 3),
+                      10**(bits // 3) - 1, (1 << bits) // 3):
+                with self.subTest(bits=bits, n=n % 1000):
+                    s = str(n)
+                    self.assertEqual(s, _pylong.int_to_decimal_string(n))
+                    self.assertEqual(str(-n), '-' + s)
+                    self.assertEqual('%d' % n, s)
+                    self.assertEqual(int(s), n)
+
+    def test_subquadratic_str_to_int(self):
+        digits = '0123456789abcdefghijklmnopqrstuvwxyz'
+        rng = random.Random(9)
+        for base in (3, 6, 10, 12, 36):
+            for ndigits in (999, 1001, 4096, 20_000):
+                with self.subTest(base=base, ndigits=ndigits):
+                    s = ''.join(rng.choice(digits[:base])
+                                for _ in range(ndigits))
+                    expected = 0
+                    for i in range(0, ndigits, 500):
+                        chunk = s[i:i+500]
+                        expected = (expected * base**len(chunk) +
+                                    int(chunk, base))
+                    self.assertEqual(int(s, base), expected)
+                    u = '_'.join(s[i:i+3] for i in range(0, ndigits, 3))
+                    self.assertEqual(int(u, base), expected)
+                    self.assertEqual(int('-' + '0' * 2000 + s, base),
+                                     -expected)
+        # Leading zeros are dropped before the shared small int is made and
+        # negated, so the result is the cached -1 and 1 stays 1.
+        n = int('-' + '0' * 5000 + '1')
+        self.assertEqual(n, -1)
+        if support.check_impl_detail(cpython=True):
+            self.assertIs(n, int('-1'))
+        self.assertEqual(int('0' * 5000 + '1'), 1)
+        self.assertEqual(int('0' * 5000), 0)
 
 if __name__ == "__main__":
     unittest.main()
@@ -1,7 +1,8 @@
 import sys
 from test import list_tests
-from test.support import cpython_only
+from test.support import cpython_only, threading_helper
 import pickle
+import threading
 import unittest
 
 class ListTest(list_tests.CommonTest):
@@ -269,6 +270,42 @@ def __eq__(self, other):
         lst = [X(), X()]
         X() in lst
 
+    @threading_helper.requires_working_threading()
+    def test_shared_append_and_read(self):
+        # Readers index a list without its lock while another thread
+        # appends to it: every index below the length they see must hold
+        # the item that was appended there.
+        lst = []
+        n = 20000
+        done = False
+        errors = []
+
+        def reader():
+            while not done:
+                size = len(lst)
+                for i in range(max(size - 10, 0), size):
+                    if lst[i] != i % n:
+                        errors.append((i, lst[i]))
+                        return
+                for i, x in enumerate(lst):
+                    if x != i % n:
+                        errors.append((i, x))
+                        return
+
+        def writer():
+            nonlocal done, lst
+            for i in range(n):
+                lst.append(i)
+            lst *= 2
+            done = True
+
+        threads = [threading.Thread(target=reader) for _ in range(2)]
+        threads.append(threading.Thread(target=writer))
+        with threading_helper.start_threads(threads):
+            pass
+        self.assertEqual(errors, [])
+        self.assertEqual(lst, list(range(n)) * 2)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -1,4 +1,6 @@
+import contextlib
 import dis
+import io
 import textwrap
 import unittest
 
@@ -74,7 +76,10 @@ def test_lltrace_different_module(self):
         self.assertIn('FOR_ITER', stdout)
         self.assertIn('this is an example', stdout)
 
-        # check that offsets match the output of dis.dis()
+        # check that offsets match the output of dis.dis(); code is only
+        # quickened once it runs, so run example() here first too
+        with contextlib.redirect_stdout(io.StringIO()):
+            example()
         instr_map = {i.offset: i for i in dis.get_instructions(example, adaptive=True)}
         for line in stdout.splitlines():
             offset, colon, opname_oparg = line.partition(":")
@@ -88,6 +93,9 @@ def test_lltrace_different_module(self):
             else:
                 (opname,) = opname_oparg
                 oparg = None
+            if opname == "RESUME_QUICKEN":
+                # Rewrites itself to RESUME when it runs
+                opname = "RESUME"
             self.assertEqual(instr_map[offset].opname, opname)
             self.assertEqual(instr_map[offset].arg, oparg)
 
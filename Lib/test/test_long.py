@@ -12,6 +12,9 @@
 BASE = 2 ** SHIFT
 MASK = BASE - 1
 KARATSUBA_CUTOFF = 70   # from longobject.c
+TOOM3_CUTOFF = 250      # from longobject.c
+NTT_CUTOFF = 3000       # from longobject.c
+NEWTON_DIV_CUTOFF = 700 # from longobject.c
 
 # Max number of base BASE digits to use in test cases.  Doubling
 # this will more than double the runtime.
@@ -229,6 +232,67 @@ def test_karatsuba(self):
                          1)
                     self.assertEqual(x, y)
 
+    def test_toom_cook_and_ntt(self):
+        digits = [TOOM3_CUTOFF, TOOM3_CUTOFF + 1, TOOM3_CUTOFF * 3 + 2,
+                  NTT_CUTOFF - 1, NTT_CUTOFF, NTT_CUTOFF * 3 + 1]
+        bits = [digit * SHIFT for digit in digits]
+
+        # Products of long strings of 1 bits have maximal carries.
+        for abits in bits:
+            a = (1 << abits) - 1
+            for bbits in bits:
+                if bbits < abits:
+                    continue
+                with self.subTest(abits=abits, bbits=bbits):
+                    b = (1 << bbits) - 1
+                    self.assertEqual(a * b, (1 << (abits + bbits)) -
+                                            (1 << abits) -
+                                            (1 << bbits) + 1)
+                    self.assertEqual(a * a, (1 << (2 * abits)) -
+                                            (1 << (abits + 1)) + 1)
+
+        # Compare with a sum of products with short chunks of b, which are
+        # computed by the schoolbook algorithm.
+        chunk = KARATSUBA_CUTOFF // 2
+        for adigits in digits:
+            for bdigits in digits:
+                if bdigits < adigits:
+                    continue
+                a = self.getran(adigits)
+                b = self.getran(bdigits)
+                with self.subTest(adigits=adigits, bdigits=bdigits):
+                    expected = 0
+                    mag = abs(b)
+                    mask = (1 << (chunk * SHIFT)) - 1
+                    for i in range(0, bdigits, chunk):
+                        piece = (mag >> (i * SHIFT)) & mask
+                        expected += (a * piece) << (i * SHIFT)
+                    if b < 0:
+                        expected = -expected
+                    self.assertEqual(a * b, expected)
+                    self.assertEqual(b * a, expected)
+
+    def test_newton_division(self):
+        digits = [NEWTON_DIV_CUTOFF, NEWTON_DIV_CUTOFF + 1,
+                  NEWTON_DIV_CUTOFF * 3 + 2, NTT_CUTOFF * 2]
+        for qdigits in digits:
+            for wdigits in digits:
+                with self.subTest(qdigits=qdigits, wdigits=wdigits):
+                    w = self.getran(wdigits)
+                    x = self.getran(qdigits + wdigits)
+                    self.check_division(x, w)
+                    # Exact quotients and remainders next to 0 and w.
+                    q = self.getran(qdigits)
+                    self.check_division(q * w, w)
+                    self.check_division(q * w - 1, w)
+                    self.check_division(q * w + w - 1, w)
+                    # Solid strings of 1 bits.
+                    wbits = wdigits * SHIFT
+                    xbits = (qdigits + wdigits) * SHIFT
+                    self.check_division((1 << xbits) - 1, (1 << wbits) - 1)
+                    self.check_division(1 << xbits, (1 << wbits) - 1)
+                    self.check_division((1 << xbits) - 1, 1 << (wbits - 1))
+
     def check_bitop_identities_1(self, x):
         eq = self.assertEqual
         with self.subTest(x=x):
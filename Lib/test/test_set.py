@@ -465,6 +465,40 @@ def test_pop(self):
             self.assertNotIn(elem, self.s)
         self.assertRaises(KeyError, self.s.pop)
 
+    def test_pop_after_discard(self):
+        s = self.thetype(range(50))
+        for i in range(0, 50, 3):
+            s.discard(i)
+        s.update(range(100, 110))
+        expected = set(s)
+        popped = set()
+        while s:
+            popped.add(s.pop())
+        self.assertEqual(popped, expected)
+        s.add(1)
+        self.assertEqual(s.pop(), 1)
+
+    def test_add_discard_churn(self):
+        # Deleted entries are purged when the table fills up, so it does
+        # not grow when elements are repeatedly added and removed.
+        s = self.thetype(range(100))
+        size = s.__sizeof__()
+        for i in range(100, 20_000):
+            s.add(i)
+            s.discard(i - 100)
+            self.assertNotIn(i - 100, s)
+        self.assertEqual(s, set(range(19_900, 20_000)))
+        self.assertLessEqual(s.__sizeof__(), size)
+
+    def test_hash_after_discard(self):
+        s = self.thetype(range(10))
+        s.discard(3)
+        s.discard(7)
+        f = frozenset(range(10)) - {3, 7}
+        # Looking up a set hashes it as a frozenset
+        self.assertIn(s, {f})
+        self.assertEqual(hash(frozenset(s)), hash(f))
+
     def test_update(self):
         retval = self.s.update(self.otherword)
         self.assertEqual(retval, None)
@@ -8,6 +8,7 @@
 import test.support
 from test import support
 from test.support import os_helper
+from test.support import script_helper
 from test.support import socket_helper
 from test.support import captured_stderr
 from test.support.os_helper import TESTFN, EnvironmentVarGuard
@@ -15,6 +16,7 @@
 import builtins
 import glob
 import io
+import marshal
 import os
 import re
 import shutil
@@ -558,6 +560,40 @@ def test_startup_interactivehook_isolated_explicit(self):
             'import site, sys; site.enablerlcompleter(); sys.exit(hasattr(sys, "__interactivehook__"))']).wait()
         self.assertTrue(r, "'__interactivehook__' not added by enablerlcompleter()")
 
+    @support.requires_subprocess()
+    def test_startup_cache(self):
+        code = ('import sys; print(repr((sys.path, sys.prefix, sys.exec_prefix, '
+                'sys.executable, sys._stdlib_dir)))')
+        with os_helper.temp_dir() as cache_dir, os_helper.temp_dir() as path:
+            def run(*args):
+                stdout = script_helper.assert_python_ok(
+                    '-c', code, *args, PYTHONPATH=path,
+                    PYTHONSTARTUPCACHE=cache_dir).out
+                return ast.literal_eval(stdout.decode())
+
+            expected = run()
+            self.assertEqual(sorted(os.listdir(cache_dir)),
+                             ['getpath.cache', 'site.cache'])
+            self.assertEqual(run(), expected)
+
+            # Script arguments share the cache entry
+            self.assertEqual(run('arg1'), expected)
+            self.assertEqual(run('arg2', 'arg3'), expected)
+            with open(os.path.join(cache_dir, 'getpath.cache'), 'rb') as f:
+                self.assertEqual(len(marshal.load(f)), 1)
+
+            # A new sitecustomize module is not hidden by the cache
+            with open(os.path.join(path, 'sitecustomize.py'), 'w') as f:
+                f.write('import sys; sys.path.append("customized")\n')
+            self.assertEqual(run()[0], expected[0] + ['customized'])
+
+            # The cache is not used in isolated mode
+            shutil.rmtree(cache_dir)
+            os.mkdir(cache_dir)
+            script_helper.assert_python_ok('-I', '-c', code,
+                                           PYTHONSTARTUPCACHE=cache_dir)
+            self.assertEqual(os.listdir(cache_dir), [])
+
 class _pthFileTests(unittest.TestCase):
 
     if sys.platform == 'win32':
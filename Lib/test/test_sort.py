@@ -1,4 +1,6 @@
 from test import support
+from test.support import import_helper
+import os
 import random
 import unittest
 from functools import cmp_to_key
@@ -384,6 +386,80 @@ def test_none_in_tuples(self):
         actual = sorted([(None, 2), (None, 1)])
         self.assertEqual(actual, expected)
 
+    def test_radix(self):
+        # Lists of at least 512 word-sized ints or floats are radix sorted.
+        # Keys are distinct objects, so the identity checks cover stability.
+        n = 2000
+        values = [0.0, -0.0, 1.5, -1.5, float('inf'), -float('inf'), 5e-324]
+        lists = [[random.randrange(-2**60 + 1, 2**60) for _ in range(n)],
+                 [random.randrange(-10, 10) * 1000 for _ in range(n)],
+                 [random.randrange(-2**30, 2**30) << 29 for _ in range(n)],
+                 [random.choice(values) * 1.0 for _ in range(n)],
+                 [random.uniform(-1e300, 1e300) for _ in range(n)],
+                 # Not eligible: big ints and NaNs
+                 [random.randrange(2**62) for _ in range(n)],
+                 [random.random() for _ in range(n)] + [float('nan')]]
+        for L in lists:
+            check_against_PyObject_RichCompareBool(self, L)
+            optimized = sorted(L, reverse=True)
+            reference = [y[1] for y in sorted([(0, x) for x in L],
+                                              reverse=True)]
+            for opt, ref in zip(optimized, reference):
+                self.assertIs(opt, ref)
+
+    def test_parallel(self):
+        # Large enough to be split between threads where there are several
+        # CPUs.  Sort indices by key to check stability.
+        n = 100_003
+        keys = [[str(random.randrange(1000)) for _ in range(n)],
+                [chr(random.randrange(256)) * random.randrange(3)
+                 for _ in range(n)],
+                # Radix sorted instead: word-sized ints and floats
+                [random.randrange(-1000, 1000) for _ in range(n)],
+                [random.randrange(100) / 4 for _ in range(n)],
+                # Not eligible: big ints and non-latin strings
+                [random.randrange(1000) << 80 for _ in range(n)],
+                [chr(0x100 + random.randrange(1000)) for _ in range(n)]]
+        for K in keys:
+            L = K[:]
+            L.sort(parallel=True)
+            self.assertEqual(L, sorted(K))
+            for reverse in False, True:
+                expected = sorted(range(n), key=K.__getitem__,
+                                  reverse=reverse)
+                actual = sorted(range(n), key=K.__getitem__,
+                                reverse=reverse, parallel=True)
+                self.assertEqual(actual, expected)
+
+        self.assertEqual(sorted([3, 1, 2], parallel=True), [1, 2, 3])
+        self.assertRaises(TypeError, [0, 'foo'].sort, parallel=True)
+
+    def force_parallel_sort_threads(self, n):
+        # Use n threads whatever the number of CPUs, so that the parallel
+        # path is taken on any machine.
+        _testinternalcapi = import_helper.import_module('_testinternalcapi')
+        old = _testinternalcapi.set_parallel_sort_threads(n)
+        self.addCleanup(_testinternalcapi.set_parallel_sort_threads, old)
+
+    def test_parallel_threads(self):
+        # An odd number of runs leaves one out of some merge rounds
+        for nthreads in 2, 5:
+            with self.subTest(nthreads=nthreads):
+                self.force_parallel_sort_threads(nthreads)
+                self.test_parallel()
+
+    @support.requires_fork()
+    def test_parallel_after_fork(self):
+        # The worker threads of the parent are gone in the child
+        self.force_parallel_sort_threads(4)
+        L = [str(random.random()) for _ in range(100_000)]
+        expected = sorted(L)
+        self.assertEqual(sorted(L, parallel=True), expected)
+        pid = os.fork()
+        if pid == 0:
+            os._exit(0 if sorted(L, parallel=True) == expected else 1)
+        support.wait_process(pid, exitcode=0)
+
 #==============================================================================
 
 if __name__ == "__main__":
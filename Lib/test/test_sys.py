@@ -724,6 +724,59 @@ def test_sys_getwindowsversion_no_instantiation(self):
     def test_clear_type_cache(self):
         sys._clear_type_cache()
 
+    @test.support.cpython_only
+    @threading_helper.requires_working_threading()
+    def test_dict_layout_stats(self):
+        import threading
+
+        def stats():
+            s = sys._dict_layout_stats()
+            self.assertEqual(set(s), {'unshared', 'unshared_keys_full',
+                                      'unshared_incompatible_key',
+                                      'materialized', 'prepopulated_keys'})
+            return s
+
+        class C:
+            def setup(self):
+                self.a = self.b = self.c = 1
+            def cache(self):
+                self.d = 2
+
+        # The counters are process-wide, so other threads may bump them
+        # too: only check that they grow by at least the expected amount.
+        before = stats()
+        # Create many instances before any attribute is set: the names
+        # assigned in the methods are already in the shared keys.
+        objs = [C() for _ in range(100)]
+        after = stats()
+        self.assertGreaterEqual(after['prepopulated_keys'],
+                                before['prepopulated_keys'] + 4)
+        for o in objs:
+            o.setup()
+            o.cache()
+        self.assertLess(stats()['unshared'] - after['unshared'], len(objs))
+
+        o = objs[0]
+        o.__dict__[1] = 1
+        after = stats()
+        self.assertGreaterEqual(after['unshared'], before['unshared'] + 1)
+        self.assertGreaterEqual(after['unshared_incompatible_key'],
+                                before['unshared_incompatible_key'] + 1)
+        self.assertGreaterEqual(after['materialized'],
+                                before['materialized'] + 1)
+
+        # The counts of a thread are kept after it exits.
+        def worker():
+            for o in [C() for _ in range(10)]:
+                o.__dict__[1] = 1
+        before = stats()
+        thread = threading.Thread(target=worker)
+        thread.start()
+        thread.join()
+        after = stats()
+        self.assertGreaterEqual(after['unshared_incompatible_key'],
+                                before['unshared_incompatible_key'] + 10)
+
     @support.requires_subprocess()
     def test_ioencoding(self):
         env = dict(os.environ)
@@ -1495,7 +1548,7 @@ def delx(self): del self.__x
         # frozenset
         PySet_MINSIZE = 8
         samples = [[], range(10), range(50)]
-        s = size('3nPP' + PySet_MINSIZE*'nP' + '2nP')
+        s = size('3nP2n' + PySet_MINSIZE*'b' + (PySet_MINSIZE*2//3)*'nP' + 'P')
         for sample in samples:
             minused = len(sample)
             if minused == 0: tmp = 1
@@ -1509,8 +1562,10 @@ def delx(self): del self.__x
                 check(set(sample), s)
                 check(frozenset(sample), s)
             else:
-                check(set(sample), s + newsize*calcsize('nP'))
-                check(frozenset(sample), s + newsize*calcsize('nP'))
+                # one byte per index slot and two thirds as many entries
+                tablesize = newsize + (newsize*2//3)*calcsize('nP')
+                check(set(sample), s + tablesize)
+                check(frozenset(sample), s + tablesize)
         # setiterator
         check(iter(set()), size('P3n'))
         # slice
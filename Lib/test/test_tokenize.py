@@ -2632,6 +2632,38 @@ def fib(n):
 
         self.assertEqual(get_tokens(code), get_tokens(code_no_cont))
 
+    def test_long_tokens(self):
+        # Identifiers, comments and string bodies are scanned several
+        # characters at a time: check that their ends are found wherever
+        # they fall.
+        def get_tokens(source):
+            return [(t.type, t.string, t.start, t.end)
+                    for t in _generate_tokens_from_c_tokenizer(source)]
+
+        for n in range(1, 20):
+            ident = 'x' * n
+            body = '\xe9' * (n % 3) + 'b' * n
+            with self.subTest(n=n):
+                self.assertEqual(get_tokens(f'{ident}=1')[:2], [
+                    (NAME, ident, (1, 0), (1, n)),
+                    (token.EQUAL, '=', (1, n), (1, n + 1)),
+                ])
+                for string in (f'"{body}"', f"'{body}\"{body}'",
+                               f'"{body}\\"{body}"', f"'{body}\\\\'",
+                               f'"{body}\\\n{body}"'):
+                    # Columns are offsets in bytes
+                    lines = string.encode().splitlines()
+                    end = (len(lines), len(lines[-1]))
+                    self.assertEqual(get_tokens(string)[0],
+                                     (STRING, string, (1, 0), end))
+                string = f'"""{body}\n{body}"""'
+                self.assertEqual(get_tokens(string)[0],
+                                 (STRING, string, (1, 0),
+                                  (2, len(body.encode()) + 3)))
+                self.assertEqual(
+                    [t[0] for t in get_tokens(f'{ident}  # {body}"\'\n1')],
+                    [NAME, NEWLINE, NUMBER, NEWLINE])
+
 
 class CTokenizerBufferTests(unittest.TestCase):
     def test_newline_at_the_end_of_buffer(self):
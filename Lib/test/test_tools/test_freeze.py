@@ -1,5 +1,6 @@
 """Sanity-check tests for the "freeze" tool."""
 
+import os
 import sys
 import textwrap
 import unittest
@@ -30,3 +31,19 @@ def test_freeze_simple_script(self):
             executable = helper.freeze(python, scriptfile, outdir)
             text = helper.run(executable)
         self.assertEqual(text, 'running...')
+
+    def test_freeze_deepfreeze(self):
+        script = textwrap.dedent("""
+            import sys
+            import textwrap
+            print(textwrap.dedent('  running...'))
+            sys.exit(0)
+            """)
+        with os_helper.temp_dir() as outdir:
+            outdir, scriptfile, python = helper.prepare(script, outdir)
+            executable = helper.freeze(python, scriptfile, outdir,
+                                       deepfreeze=True)
+            self.assertTrue(os.path.exists(os.path.join(outdir,
+                                                        'deepfreeze.c')))
+            text = helper.run(executable)
+        self.assertEqual(text, 'running...')
@@ -1,3 +1,4 @@
+import atexit
 import sys
 import os
 import marshal
@@ -546,6 +547,39 @@ def testInvalidateCaches(self):
         self.assertIsNone(zipimport._zip_directory_cache.get(zi.archive))
         self.assertIsNone(zi.find_spec("name_does_not_matter"))
 
+    def testPathIndex(self):
+        files = {TESTMOD + ".py": (NOW, test_src)}
+        self.makeZip(files)
+        # Keep the archive out of the clock tick the index is written in.
+        os.utime(TEMP_ZIP, (1000, 1000))
+        filename = os_helper.TESTFN + ".index"
+        self.addCleanup(os_helper.unlink, filename)
+        PathIndex = zipimport._bootstrap_external._PathIndex
+
+        index = PathIndex(filename)
+        self.addCleanup(atexit.unregister, index.save)
+        with unittest.mock.patch.object(zipimport._bootstrap_external,
+                                        '_path_index', index):
+            zi = zipimport.zipimporter(TEMP_ZIP)
+        self.assertEqual(zi._files.keys(), files.keys())
+        index.save()
+
+        # The directory is now read from the index.
+        zipimport._zip_directory_cache.clear()
+        index = PathIndex(filename)
+        self.addCleanup(atexit.unregister, index.save)
+        with unittest.mock.patch.object(zipimport._bootstrap_external,
+                                        '_path_index', index), \
+             unittest.mock.patch.object(zipimport, '_read_directory_uncached',
+                                        side_effect=AssertionError):
+            zi = zipimport.zipimporter(TEMP_ZIP)
+        self.assertEqual(zi._files.keys(), files.keys())
+        spec = zi.find_spec(TESTMOD)
+        self.assertIsNotNone(spec)
+        mod = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(mod)
+        self.assertEqual(mod.get_name(), TESTMOD)
+
     def testZipImporterMethodsInSubDirectory(self):
         packdir = TESTPACK + os.sep
         packdir2 = packdir + TESTPACK2 + os.sep
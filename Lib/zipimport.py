@@ -340,7 +340,21 @@ def _get_module_info(self, fullname):
 #
 # Directories can be recognized by the trailing path_sep in the name,
 # data_size and file_offset are 0.
+#
+# If PYTHONPATHINDEX is set, the dict is cached across processes in the
+# path index of importlib._bootstrap_external.
 def _read_directory(archive):
+    path_index = _bootstrap_external._path_index
+    if path_index is not None:
+        try:
+            mtime = _bootstrap_external._path_stat(archive).st_mtime
+        except OSError:
+            pass
+        else:
+            return path_index.get(archive, mtime, _read_directory_uncached)
+    return _read_directory_uncached(archive)
+
+def _read_directory_uncached(archive):
     try:
         fp = _io.open_code(archive)
     except OSError:
@@ -401,12 +415,16 @@ def _read_directory(archive):
             files = {}
             # Start of Central Directory
             count = 0
+            # Read it in one go and parse it from memory.
             try:
                 fp.seek(header_position)
+                data = fp.read()
             except OSError:
                 raise ZipImportError(f"can't read Zip file: {archive!r}", path=archive)
+            pos = 0
             while True:
-                buffer = fp.read(46)
+                buffer = data[pos:pos+46]
+                pos += 46
                 if len(buffer) < 4:
                     raise EOFError('EOF read where not expected')
                 # Start of file header
@@ -414,35 +432,28 @@ def _read_directory(archive):
                     break                                # Bad: Central Dir File Header
                 if len(buffer) != 46:
                     raise EOFError('EOF read where not expected')
-                flags = _unpack_uint16(buffer[8:10])
-                compress = _unpack_uint16(buffer[10:12])
-                time = _unpack_uint16(buffer[12:14])
-                date = _unpack_uint16(buffer[14:16])
-                crc = _unpack_uint32(buffer[16:20])
-                data_size = _unpack_uint32(buffer[20:24])
-                file_size = _unpack_uint32(buffer[24:28])
-                name_size = _unpack_uint16(buffer[28:30])
-                extra_size = _unpack_uint16(buffer[30:32])
-                comment_size = _unpack_uint16(buffer[32:34])
-                file_offset = _unpack_uint32(buffer[42:46])
+                # Decode the fields with shifts of a single int rather than
+                # unpacking each slice.
+                header = int.from_bytes(buffer, 'little')
+                flags = (header >> 64) & 0xFFFF
+                compress = (header >> 80) & 0xFFFF
+                time = (header >> 96) & 0xFFFF
+                date = (header >> 112) & 0xFFFF
+                crc = (header >> 128) & 0xFFFFFFFF
+                data_size = (header >> 160) & 0xFFFFFFFF
+                file_size = (header >> 192) & 0xFFFFFFFF
+                name_size = (header >> 224) & 0xFFFF
+                extra_size = (header >> 240) & 0xFFFF
+                comment_size = (header >> 256) & 0xFFFF
+                file_offset = header >> 336
                 header_size = name_size + extra_size + comment_size
                 if file_offset > header_offset:
                     raise ZipImportError(f'bad local header offset: {archive!r}', path=archive)
                 file_offset += arc_offset
 
-                try:
-                    name = fp.read(name_size)
-                except OSError:
-                    raise ZipImportError(f"can't read Zip file: {archive!r}", path=archive)
-                if len(name) != name_size:
-                    raise ZipImportError(f"can't read Zip file: {archive!r}", path=archive)
-                # On Windows, calling fseek to skip over the fields we don't use is
-                # slower than reading the data because fseek flushes stdio's
-                # internal buffers.    See issue #8745.
-                try:
-                    if len(fp.read(header_size - name_size)) != header_size - name_size:
-                        raise ZipImportError(f"can't read Zip file: {archive!r}", path=archive)
-                except OSError:
+                name = data[pos:pos+name_size]
+                pos += header_size
+                if pos > len(data):
                     raise ZipImportError(f"can't read Zip file: {archive!r}", path=archive)
 
                 if flags & 0x800:
@@ -615,7 +626,7 @@ def _unmarshal_code(self, pathname, fullpath, fullname, data):
                     f'bytecode is stale for {fullname!r}')
                 return None
 
-    code = marshal.loads(data[16:])
+    code = marshal.loads(memoryview(data)[16:])
     if not isinstance(code, _code_type):
         raise TypeError(f'compiled module {pathname!r} is not a code object')
     return code
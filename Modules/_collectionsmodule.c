@@ -1,5 +1,8 @@
 #include "Python.h"
 #include "pycore_call.h"          // _PyObject_CallNoArgs()
+#include "pycore_critical_section.h" // Py_BEGIN_CRITICAL_SECTION()
+#include "pycore_dict.h"          // _PyDict_FetchItem_KnownHash()
+#include "pycore_gc.h"            // _PyObject_GC_SET_SHARED()
 #include "pycore_long.h"          // _PyLong_GetZero()
 #include "structmember.h"         // PyMemberDef
 
@@ -2357,6 +2360,607 @@ static PyTypeObject defdict_type = {
     PyObject_GC_Del,                    /* tp_free */
 };
 
+/* ConcurrentDict type ******************************************************/
+
+/* A ConcurrentDict is a mapping for data shared between many threads, such
+ * as a cache.  It is split into a fixed number of ordinary dicts (segments)
+ * and the hash of a key selects its segment.  A write locks only the
+ * segment of its key, so threads inserting different keys rarely contend,
+ * and a resize only rehashes the segment that grew -- about 1/32 of the
+ * entries -- instead of stalling every writer behind one large resize.
+ *
+ * The segments are marked as shared when they are created, so lookups
+ * read them without taking the lock: a concurrent resize retires the old
+ * keys table through QSBR and a reader never sees it freed.
+ *
+ * The segment index is taken from the high bits of the hash multiplied by
+ * a Fibonacci constant, so that consecutive hashes, like those of small
+ * ints, land in different segments and threads working on nearby keys
+ * don't contend for the same lock.
+ */
+
+#define CDICT_SEGMENT_BITS 5
+#define CDICT_SEGMENTS (1 << CDICT_SEGMENT_BITS)
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *segments[CDICT_SEGMENTS];
+    PyObject *weakreflist;
+} cdictobject;
+
+static PyTypeObject cdict_type;
+
+#define ConcurrentDict_Check(op) PyObject_TypeCheck(op, &cdict_type)
+
+static inline PyObject *
+cdict_segment(cdictobject *cd, Py_hash_t hash)
+{
+#if SIZEOF_SIZE_T == 8
+    size_t i = ((size_t)hash * (size_t)0x9E3779B97F4A7C15ULL)
+               >> (64 - CDICT_SEGMENT_BITS);
+#else
+    size_t i = ((size_t)hash * (size_t)0x9E3779B9UL)
+               >> (32 - CDICT_SEGMENT_BITS);
+#endif
+    return cd->segments[i];
+}
+
+static PyObject *
+cdict_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    cdictobject *cd = (cdictobject *)type->tp_alloc(type, 0);
+    if (cd == NULL)
+        return NULL;
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        PyObject *seg = PyDict_New();
+        if (seg == NULL) {
+            Py_DECREF(cd);
+            return NULL;
+        }
+        _PyObject_GC_SET_SHARED(seg);
+        cd->segments[i] = seg;
+    }
+    return (PyObject *)cd;
+}
+
+static int
+cdict_traverse(cdictobject *cd, visitproc visit, void *arg)
+{
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        Py_VISIT(cd->segments[i]);
+    }
+    return 0;
+}
+
+/* The segments are emptied rather than released, so that a ConcurrentDict
+   reached by a finalizer after being cleared is still usable. */
+static int
+cdict_tp_clear(cdictobject *cd)
+{
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        if (cd->segments[i] != NULL)
+            PyDict_Clear(cd->segments[i]);
+    }
+    return 0;
+}
+
+static void
+cdict_dealloc(cdictobject *cd)
+{
+    PyObject_GC_UnTrack(cd);
+    if (cd->weakreflist != NULL)
+        PyObject_ClearWeakRefs((PyObject *)cd);
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        Py_CLEAR(cd->segments[i]);
+    }
+    Py_TYPE(cd)->tp_free(cd);
+}
+
+static Py_ssize_t
+cdict_length(cdictobject *cd)
+{
+    Py_ssize_t n = 0;
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        n += PyDict_Size(cd->segments[i]);
+    }
+    return n;
+}
+
+static PyObject *
+cdict_subscript(cdictobject *cd, PyObject *key)
+{
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1)
+        return NULL;
+    PyObject *value = _PyDict_FetchItem_KnownHash(
+        cdict_segment(cd, hash), key, hash);
+    if (value == NULL && !PyErr_Occurred())
+        _PyErr_SetKeyError(key);
+    return value;
+}
+
+static int
+cdict_ass_subscript(cdictobject *cd, PyObject *key, PyObject *value)
+{
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1)
+        return -1;
+    PyObject *seg = cdict_segment(cd, hash);
+    if (value == NULL)
+        return _PyDict_DelItem_KnownHash(seg, key, hash);
+    return _PyDict_SetItem_KnownHash(seg, key, value, hash);
+}
+
+static int
+cdict_contains(cdictobject *cd, PyObject *key)
+{
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1)
+        return -1;
+    PyObject *value = _PyDict_FetchItem_KnownHash(
+        cdict_segment(cd, hash), key, hash);
+    if (value == NULL)
+        return PyErr_Occurred() ? -1 : 0;
+    Py_DECREF(value);
+    return 1;
+}
+
+/* Return a new dict with the contents of cd.  Each segment is copied
+   under its own lock, so the copy is consistent segment by segment but
+   not as a whole if other threads are writing. */
+static PyObject *
+cdict_to_dict(cdictobject *cd)
+{
+    PyObject *dict = PyDict_New();
+    if (dict == NULL)
+        return NULL;
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        if (PyDict_Update(dict, cd->segments[i]) < 0) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+    }
+    return dict;
+}
+
+enum {
+    CDICT_KEYS,
+    CDICT_VALUES,
+    CDICT_ITEMS,
+};
+
+/* Return a list of the keys, values or items of cd, with the same
+   consistency as cdict_to_dict(). */
+static PyObject *
+cdict_to_list(cdictobject *cd, int kind)
+{
+    PyObject *list = PyList_New(0);
+    if (list == NULL)
+        return NULL;
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        PyObject *seg = cd->segments[i];
+        Py_ssize_t pos = 0;
+        PyObject *key, *value, *item;
+        int err = 0;
+
+        Py_BEGIN_CRITICAL_SECTION(seg);
+        while (PyDict_Next(seg, &pos, &key, &value)) {
+            /* Calls below may suspend the critical section and let
+               another thread remove the entry. */
+            Py_INCREF(key);
+            Py_INCREF(value);
+            if (kind == CDICT_KEYS)
+                item = Py_NewRef(key);
+            else if (kind == CDICT_VALUES)
+                item = Py_NewRef(value);
+            else
+                item = PyTuple_Pack(2, key, value);
+            Py_DECREF(key);
+            Py_DECREF(value);
+            if (item == NULL) {
+                err = -1;
+                break;
+            }
+            err = PyList_Append(list, item);
+            Py_DECREF(item);
+            if (err < 0)
+                break;
+        }
+        Py_END_CRITICAL_SECTION;
+        if (err < 0) {
+            Py_DECREF(list);
+            return NULL;
+        }
+    }
+    return list;
+}
+
+/* Store all items of the dict d in cd. */
+static int
+cdict_merge_dict(cdictobject *cd, PyObject *d)
+{
+    Py_ssize_t pos = 0;
+    PyObject *key, *value;
+    Py_hash_t hash;
+
+    while (_PyDict_Next(d, &pos, &key, &value, &hash)) {
+        if (_PyDict_SetItem_KnownHash(cdict_segment(cd, hash),
+                                      key, value, hash) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static PyObject *
+cdict_update(cdictobject *cd, PyObject *args, PyObject *kwds)
+{
+    PyObject *other = NULL;
+    int err;
+
+    if (PyTuple_GET_SIZE(args) == 1 && kwds == NULL &&
+            ConcurrentDict_Check(PyTuple_GET_ITEM(args, 0))) {
+        other = cdict_to_dict((cdictobject *)PyTuple_GET_ITEM(args, 0));
+    }
+    else {
+        /* Accept exactly the arguments of dict(), then insert the result
+           one segment at a time. */
+        other = PyObject_Call((PyObject *)&PyDict_Type, args, kwds);
+    }
+    if (other == NULL)
+        return NULL;
+    err = cdict_merge_dict(cd, other);
+    Py_DECREF(other);
+    if (err < 0)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static int
+cdict_init(cdictobject *cd, PyObject *args, PyObject *kwds)
+{
+    if (PyTuple_GET_SIZE(args) == 0 && kwds == NULL)
+        return 0;
+    PyObject *result = cdict_update(cd, args, kwds);
+    if (result == NULL)
+        return -1;
+    Py_DECREF(result);
+    return 0;
+}
+
+static PyObject *
+cdict_get(cdictobject *cd, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *key, *deflt = Py_None;
+
+    if (!_PyArg_CheckPositional("get", nargs, 1, 2))
+        return NULL;
+    key = args[0];
+    if (nargs == 2)
+        deflt = args[1];
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1)
+        return NULL;
+    PyObject *value = _PyDict_FetchItem_KnownHash(
+        cdict_segment(cd, hash), key, hash);
+    if (value == NULL && !PyErr_Occurred())
+        return Py_NewRef(deflt);
+    return value;
+}
+
+static PyObject *
+cdict_setdefault(cdictobject *cd, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *key, *deflt = Py_None;
+
+    if (!_PyArg_CheckPositional("setdefault", nargs, 1, 2))
+        return NULL;
+    key = args[0];
+    if (nargs == 2)
+        deflt = args[1];
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1)
+        return NULL;
+    return _PyDict_SetDefault_KnownHash(cdict_segment(cd, hash),
+                                        key, hash, deflt);
+}
+
+static PyObject *
+cdict_pop(cdictobject *cd, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *key, *deflt = NULL;
+
+    if (!_PyArg_CheckPositional("pop", nargs, 1, 2))
+        return NULL;
+    key = args[0];
+    if (nargs == 2)
+        deflt = args[1];
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1)
+        return NULL;
+    return _PyDict_Pop_KnownHash(cdict_segment(cd, hash), key, hash, deflt);
+}
+
+static PyObject *
+cdict_popitem(cdictobject *cd, PyObject *Py_UNUSED(ignored))
+{
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        PyObject *seg = cd->segments[i];
+        if (PyDict_Size(seg) == 0)
+            continue;
+        PyObject *item = PyObject_CallMethod(seg, "popitem", NULL);
+        if (item != NULL)
+            return item;
+        /* Another thread emptied the segment in the meantime. */
+        if (!PyErr_ExceptionMatches(PyExc_KeyError))
+            return NULL;
+        PyErr_Clear();
+    }
+    PyErr_SetString(PyExc_KeyError, "popitem(): dictionary is empty");
+    return NULL;
+}
+
+static PyObject *
+cdict_clearmethod(cdictobject *cd, PyObject *Py_UNUSED(ignored))
+{
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        PyDict_Clear(cd->segments[i]);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+cdict_keys(cdictobject *cd, PyObject *Py_UNUSED(ignored))
+{
+    return cdict_to_list(cd, CDICT_KEYS);
+}
+
+static PyObject *
+cdict_values(cdictobject *cd, PyObject *Py_UNUSED(ignored))
+{
+    return cdict_to_list(cd, CDICT_VALUES);
+}
+
+static PyObject *
+cdict_items(cdictobject *cd, PyObject *Py_UNUSED(ignored))
+{
+    return cdict_to_list(cd, CDICT_ITEMS);
+}
+
+static PyObject *
+cdict_iter(cdictobject *cd)
+{
+    PyObject *keys = cdict_to_list(cd, CDICT_KEYS);
+    if (keys == NULL)
+        return NULL;
+    PyObject *it = PyObject_GetIter(keys);
+    Py_DECREF(keys);
+    return it;
+}
+
+static PyObject *
+cdict_copy(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    cdictobject *cd = (cdictobject *)self;
+    cdictobject *result;
+
+    result = (cdictobject *)cdict_new(Py_TYPE(cd), NULL, NULL);
+    if (result == NULL)
+        return NULL;
+    /* A key lands in the same segment of the copy. */
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        if (PyDict_Update(result->segments[i], cd->segments[i]) < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+    }
+    return (PyObject *)result;
+}
+
+static PyObject *
+cdict_repr(cdictobject *cd)
+{
+    PyObject *dict, *result;
+    int status = Py_ReprEnter((PyObject *)cd);
+
+    if (status != 0) {
+        if (status < 0)
+            return NULL;
+        return PyUnicode_FromString("...");
+    }
+    dict = cdict_to_dict(cd);
+    if (dict == NULL) {
+        Py_ReprLeave((PyObject *)cd);
+        return NULL;
+    }
+    result = PyUnicode_FromFormat("%s(%R)", _PyType_Name(Py_TYPE(cd)), dict);
+    Py_DECREF(dict);
+    Py_ReprLeave((PyObject *)cd);
+    return result;
+}
+
+static PyObject *
+cdict_richcompare(PyObject *v, PyObject *w, int op)
+{
+    PyObject *a, *b, *result;
+
+    if ((op != Py_EQ && op != Py_NE) ||
+            !(PyDict_Check(w) || ConcurrentDict_Check(w)))
+        Py_RETURN_NOTIMPLEMENTED;
+    a = cdict_to_dict((cdictobject *)v);
+    if (a == NULL)
+        return NULL;
+    if (ConcurrentDict_Check(w))
+        b = cdict_to_dict((cdictobject *)w);
+    else
+        b = Py_NewRef(w);
+    if (b == NULL) {
+        Py_DECREF(a);
+        return NULL;
+    }
+    result = PyObject_RichCompare(a, b, op);
+    Py_DECREF(a);
+    Py_DECREF(b);
+    return result;
+}
+
+static PyObject *
+cdict_reduce(cdictobject *cd, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *dict = cdict_to_dict(cd);
+    if (dict == NULL)
+        return NULL;
+    return Py_BuildValue("O(N)", Py_TYPE(cd), dict);
+}
+
+static PyObject *
+cdict_sizeof(cdictobject *cd, void *unused)
+{
+    Py_ssize_t res = _PyObject_SIZE(Py_TYPE(cd));
+    for (int i = 0; i < CDICT_SEGMENTS; i++) {
+        res += _PyDict_SizeOf((PyDictObject *)cd->segments[i]);
+    }
+    return PyLong_FromSsize_t(res);
+}
+
+static PyMappingMethods cdict_as_mapping = {
+    (lenfunc)cdict_length,              /* mp_length */
+    (binaryfunc)cdict_subscript,        /* mp_subscript */
+    (objobjargproc)cdict_ass_subscript, /* mp_ass_subscript */
+};
+
+static PySequenceMethods cdict_as_sequence = {
+    0,                                  /* sq_length */
+    0,                                  /* sq_concat */
+    0,                                  /* sq_repeat */
+    0,                                  /* sq_item */
+    0,                                  /* sq_slice */
+    0,                                  /* sq_ass_item */
+    0,                                  /* sq_ass_slice */
+    (objobjproc)cdict_contains,         /* sq_contains */
+};
+
+PyDoc_STRVAR(cdict_get_doc,
+"D.get(k[,d]) -> D[k] if k in D, else d.  d defaults to None.");
+
+PyDoc_STRVAR(cdict_setdefault_doc,
+"D.setdefault(k[,d]) -> D.get(k,d), also set D[k]=d if k not in D");
+
+PyDoc_STRVAR(cdict_pop_doc,
+"D.pop(k[,d]) -> v, remove specified key and return the corresponding value.\n\
+\n\
+If the key is not found, return the default if given; otherwise,\n\
+raise a KeyError.");
+
+PyDoc_STRVAR(cdict_popitem_doc,
+"D.popitem() -> (k, v), remove and return some (key, value) pair as a\n\
+2-tuple; but raise KeyError if D is empty.");
+
+PyDoc_STRVAR(cdict_clear_doc,
+"D.clear() -> None.  Remove all items from D.");
+
+PyDoc_STRVAR(cdict_update_doc,
+"D.update([E, ]**F) -> None.  Update D from mapping/iterable E and F.\n\
+\n\
+Accepts the same arguments as dict.update().");
+
+PyDoc_STRVAR(cdict_keys_doc,
+"D.keys() -> a list of D's keys");
+
+PyDoc_STRVAR(cdict_values_doc,
+"D.values() -> a list of D's values");
+
+PyDoc_STRVAR(cdict_items_doc,
+"D.items() -> a list of D's (key, value) pairs, as 2-tuples");
+
+PyDoc_STRVAR(cdict_copy_doc,
+"D.copy() -> a shallow copy of D.");
+
+static PyMethodDef cdict_methods[] = {
+    {"get",             _PyCFunction_CAST(cdict_get),
+        METH_FASTCALL,  cdict_get_doc},
+    {"setdefault",      _PyCFunction_CAST(cdict_setdefault),
+        METH_FASTCALL,  cdict_setdefault_doc},
+    {"pop",             _PyCFunction_CAST(cdict_pop),
+        METH_FASTCALL,  cdict_pop_doc},
+    {"popitem",         (PyCFunction)cdict_popitem,
+        METH_NOARGS,    cdict_popitem_doc},
+    {"clear",           (PyCFunction)cdict_clearmethod,
+        METH_NOARGS,    cdict_clear_doc},
+    {"update",          _PyCFunction_CAST(cdict_update),
+        METH_VARARGS | METH_KEYWORDS, cdict_update_doc},
+    {"keys",            (PyCFunction)cdict_keys,
+        METH_NOARGS,    cdict_keys_doc},
+    {"values",          (PyCFunction)cdict_values,
+        METH_NOARGS,    cdict_values_doc},
+    {"items",           (PyCFunction)cdict_items,
+        METH_NOARGS,    cdict_items_doc},
+    {"copy",            cdict_copy,
+        METH_NOARGS,    cdict_copy_doc},
+    {"__copy__",        cdict_copy,
+        METH_NOARGS,    cdict_copy_doc},
+    {"__reduce__",      (PyCFunction)cdict_reduce,
+        METH_NOARGS,    reduce_doc},
+    {"__sizeof__",      (PyCFunction)cdict_sizeof,
+        METH_NOARGS,    sizeof_doc},
+    {"__class_getitem__", Py_GenericAlias,
+        METH_O|METH_CLASS, PyDoc_STR("See PEP 585")},
+    {NULL,              NULL}   /* sentinel */
+};
+
+PyDoc_STRVAR(cdict_doc,
+"ConcurrentDict([mapping or iterable], /, **kwargs) --> mapping for sharing\n\
+between threads\n\
+\n\
+Keys are distributed over independently locked segments, so threads\n\
+writing different keys rarely wait for each other, and lookups do not\n\
+lock at all.  keys(), values(), items() and iteration work on a snapshot\n\
+taken one segment at a time.  The arguments are the same as for dict().");
+
+static PyTypeObject cdict_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "collections.ConcurrentDict",       /* tp_name */
+    sizeof(cdictobject),                /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    /* methods */
+    (destructor)cdict_dealloc,          /* tp_dealloc */
+    0,                                  /* tp_vectorcall_offset */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_as_async */
+    (reprfunc)cdict_repr,               /* tp_repr */
+    0,                                  /* tp_as_number */
+    &cdict_as_sequence,                 /* tp_as_sequence */
+    &cdict_as_mapping,                  /* tp_as_mapping */
+    PyObject_HashNotImplemented,        /* tp_hash */
+    0,                                  /* tp_call */
+    0,                                  /* tp_str */
+    PyObject_GenericGetAttr,            /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_MAPPING,
+                                        /* tp_flags */
+    cdict_doc,                          /* tp_doc */
+    (traverseproc)cdict_traverse,       /* tp_traverse */
+    (inquiry)cdict_tp_clear,            /* tp_clear */
+    cdict_richcompare,                  /* tp_richcompare */
+    offsetof(cdictobject, weakreflist), /* tp_weaklistoffset*/
+    (getiterfunc)cdict_iter,            /* tp_iter */
+    0,                                  /* tp_iternext */
+    cdict_methods,                      /* tp_methods */
+    0,                                  /* tp_members */
+    0,                                  /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    (initproc)cdict_init,               /* tp_init */
+    PyType_GenericAlloc,                /* tp_alloc */
+    cdict_new,                          /* tp_new */
+    PyObject_GC_Del,                    /* tp_free */
+};
+
 /* helper function for Counter  *********************************************/
 
 /*[clinic input]
@@ -2647,6 +3251,7 @@ PyDoc_STRVAR(collections_doc,
 "High performance data structures.\n\
 - deque:        ordered collection accessible from endpoints only\n\
 - defaultdict:  dict subclass with a default value factory\n\
+- ConcurrentDict: mapping with independently locked segments\n\
 ");
 
 static struct PyMethodDef collections_methods[] = {
@@ -2659,6 +3264,7 @@ collections_exec(PyObject *module) {
     PyTypeObject *typelist[] = {
         &deque_type,
         &defdict_type,
+        &cdict_type,
         &dequeiter_type,
         &dequereviter_type,
         &tuplegetter_type
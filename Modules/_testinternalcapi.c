@@ -24,6 +24,7 @@
 #include "pycore_object.h"       // _PyGC_PREHEADER_SIZE
 #include "pycore_pathconfig.h"   // _PyPathConfig_ClearGlobal()
 #include "pycore_interp.h"       // _PyInterpreterState_GetConfigCopy()
+#include "pycore_list.h"         // _PyList_SetParallelSortThreads()
 #include "pycore_pyerrors.h"     // _Py_UTF8_Edit_Cost()
 #include "pycore_pystate.h"      // _PyThreadState_GET()
 #include "osdefs.h"              // MAXPATHLEN
@@ -643,6 +644,21 @@ get_interp_settings(PyObject *self, PyObject *args)
 }
 
 
+static PyObject *
+set_parallel_sort_threads(PyObject *self, PyObject *arg)
+{
+    Py_ssize_t n = PyLong_AsSsize_t(arg);
+    if (n == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (n < 0) {
+        PyErr_SetString(PyExc_ValueError, "number of threads must be >= 0");
+        return NULL;
+    }
+    return PyLong_FromSsize_t(_PyList_SetParallelSortThreads(n));
+}
+
+
 static PyMethodDef TestMethods[] = {
     {"get_configs", get_configs, METH_NOARGS},
     {"get_recursion_depth", get_recursion_depth, METH_NOARGS},
@@ -665,6 +681,7 @@ static PyMethodDef TestMethods[] = {
     _TESTINTERNALCAPI_OPTIMIZE_CFG_METHODDEF
     {"get_interp_settings", get_interp_settings, METH_VARARGS, NULL},
     {"test_critical_sections", test_critical_sections, METH_NOARGS},
+    {"set_parallel_sort_threads", set_parallel_sort_threads, METH_O},
     {NULL, NULL} /* sentinel */
 };
 
@@ -811,6 +811,7 @@ clear_freelists(PyThreadState *tstate)
     _PyFloat_ClearFreeList(tstate);
     _PyList_ClearFreeList(tstate);
     _PyDict_ClearFreeList(tstate);
+    _PyGen_ClearFreeList(tstate);
     _PyAsyncGen_ClearFreeLists(tstate);
     _PyContext_ClearFreeList(tstate);
 }
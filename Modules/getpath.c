@@ -781,6 +781,334 @@ library_to_dict(PyObject *dict, const char *key)
 }
 
 
+/* STARTUP CACHE
+
+   If the PYTHONSTARTUPCACHE environment variable names a directory, the
+   results of getpath.py are stored in its getpath.cache file, keyed by
+   everything getpath.py reads apart from the file system, and reused by
+   later runs with the same inputs.  An entry is only used while the
+   executable it found keeps the same mtime and size.  site.py keeps its
+   own cache in the same directory.
+
+   The cache file is a marshalled dict mapping keys to
+   ((mtime, size), results) tuples, where results holds the config fields
+   that getpath.py changed. */
+
+#define STARTUP_CACHE_FILE "getpath.cache"
+#define STARTUP_CACHE_MAX_ENTRIES 64
+
+/* The config fields read by getpath.py.  Of orig_argv, it only reads the
+   executable name, so startup_cache_key() adds that one separately: the
+   script arguments must not make every run miss the cache. */
+static const char * const startup_cache_config_inputs[] = {
+    "_is_python_build", "base_exec_prefix", "base_executable",
+    "base_prefix", "exec_prefix", "executable", "home", "isolated",
+    "module_search_paths", "module_search_paths_set",
+    "platlibdir", "platstdlib_dir", "prefix", "program_name",
+    "pythonpath_env", "safe_path", "site_import", "stdlib_dir",
+    "use_environment", NULL
+};
+
+
+/* Return the path of the cache file as a new wide string, or NULL if the
+   cache is disabled. */
+static wchar_t *
+startup_cache_file(PyObject *dict, const PyConfig *config)
+{
+    if (!config->use_environment) {
+        return NULL;
+    }
+    PyObject *dir = PyDict_GetItemString(dict, "ENV_PYTHONSTARTUPCACHE");
+    if (dir == NULL || !PyUnicode_Check(dir) || !PyUnicode_GET_LENGTH(dir)) {
+        return NULL;
+    }
+    PyObject *path = PyUnicode_FromFormat("%U%c%s", dir, (int)SEP,
+                                          STARTUP_CACHE_FILE);
+    if (path == NULL) {
+        PyErr_Clear();
+        return NULL;
+    }
+    wchar_t *wpath = PyUnicode_AsWideCharString(path, NULL);
+    Py_DECREF(path);
+    if (wpath == NULL) {
+        PyErr_Clear();
+    }
+    return wpath;
+}
+
+
+/* Return the marshalled inputs of getpath.py. */
+static PyObject *
+startup_cache_key(PyObject *dict, PyObject *configDict, const PyConfig *config)
+{
+    PyObject *key = PyList_New(0);
+    if (key == NULL) {
+        return NULL;
+    }
+    /* The constants and environment variables passed to getpath.py */
+    Py_ssize_t pos = 0;
+    PyObject *name, *value;
+    while (PyDict_Next(dict, &pos, &name, &value)) {
+        if (value != Py_None && !PyUnicode_Check(value) && !PyLong_Check(value)) {
+            continue;
+        }
+        if (PyList_Append(key, name) < 0 || PyList_Append(key, value) < 0) {
+            goto error;
+        }
+    }
+    for (const char * const *p = startup_cache_config_inputs; *p; p++) {
+        value = PyDict_GetItemString(configDict, *p);
+        if (PyList_Append(key, value ? value : Py_None) < 0) {
+            goto error;
+        }
+    }
+    value = PyDict_GetItemString(configDict, "orig_argv");
+    if (value != NULL && PyList_Check(value) && PyList_GET_SIZE(value) > 0) {
+        value = PyList_GET_ITEM(value, 0);
+    }
+    else {
+        value = Py_None;
+    }
+    if (PyList_Append(key, value) < 0) {
+        goto error;
+    }
+    /* A relative program name is resolved against the current directory */
+    if (config->program_name == NULL || !_Py_isabs(config->program_name)) {
+        wchar_t cwd[MAXPATHLEN + 1];
+        if (!_Py_wgetcwd(cwd, Py_ARRAY_LENGTH(cwd))) {
+            goto error;
+        }
+        value = PyUnicode_FromWideChar(cwd, -1);
+        if (value == NULL || PyList_Append(key, value) < 0) {
+            Py_XDECREF(value);
+            goto error;
+        }
+        Py_DECREF(value);
+    }
+    Py_SETREF(key, PyMarshal_WriteObjectToString(key, Py_MARSHAL_VERSION));
+    return key;
+
+error:
+    Py_DECREF(key);
+    return NULL;
+}
+
+
+/* Return (mtime, size) of the file path, or None if it cannot be read. */
+static PyObject *
+startup_cache_file_id(PyObject *path)
+{
+    if (path == NULL || !PyUnicode_Check(path)) {
+        Py_RETURN_NONE;
+    }
+    wchar_t *wpath = PyUnicode_AsWideCharString(path, NULL);
+    if (wpath == NULL) {
+        return NULL;
+    }
+#ifdef MS_WINDOWS
+    struct _stat st;
+    int err = _wstat(wpath, &st);
+#else
+    struct stat st;
+    int err = _Py_wstat(wpath, &st);
+#endif
+    PyMem_Free(wpath);
+    if (err) {
+        Py_RETURN_NONE;
+    }
+    return Py_BuildValue("(LL)", (long long)st.st_mtime, (long long)st.st_size);
+}
+
+
+static PyObject *
+startup_cache_read(const wchar_t *path)
+{
+    PyObject *cache = NULL;
+    FILE *fp = _Py_wfopen(path, L"rb");
+    if (fp != NULL) {
+        cache = PyMarshal_ReadLastObjectFromFile(fp);
+        fclose(fp);
+        if (cache == NULL) {
+            PyErr_Clear();
+        }
+        else if (!PyDict_CheckExact(cache)) {
+            Py_CLEAR(cache);
+        }
+    }
+    if (cache == NULL) {
+        cache = PyDict_New();
+    }
+    return cache;
+}
+
+
+/* Replace the cache file atomically, ignoring errors. */
+static void
+startup_cache_write(const wchar_t *path, PyObject *cache)
+{
+    PyObject *data = PyMarshal_WriteObjectToString(cache, Py_MARSHAL_VERSION);
+    if (data == NULL) {
+        PyErr_Clear();
+        return;
+    }
+    wchar_t tmp[MAXPATHLEN + 32];
+#ifdef MS_WINDOWS
+    long pid = (long)GetCurrentProcessId();
+#else
+    long pid = (long)getpid();
+#endif
+    if (swprintf(tmp, Py_ARRAY_LENGTH(tmp), L"%ls.%ld", path, pid) < 0) {
+        Py_DECREF(data);
+        return;
+    }
+    FILE *fp = _Py_wfopen(tmp, L"wb");
+    if (fp == NULL) {
+        Py_DECREF(data);
+        return;
+    }
+    size_t size = (size_t)PyBytes_GET_SIZE(data);
+    int ok = fwrite(PyBytes_AS_STRING(data), 1, size, fp) == size;
+    ok = (fclose(fp) == 0) && ok;
+    Py_DECREF(data);
+#ifdef MS_WINDOWS
+    if (!ok || !MoveFileExW(tmp, path, MOVEFILE_REPLACE_EXISTING)) {
+        _wremove(tmp);
+    }
+#else
+    char *ctmp = _Py_EncodeLocaleRaw(tmp, NULL);
+    char *cpath = _Py_EncodeLocaleRaw(path, NULL);
+    if (ctmp != NULL && (!ok || cpath == NULL || rename(ctmp, cpath) < 0)) {
+        unlink(ctmp);
+    }
+    PyMem_RawFree(ctmp);
+    PyMem_RawFree(cpath);
+#endif
+}
+
+
+/* Apply the cached results for key to configDict.  Return 1 if they were
+   found, 0 if not and -1 on error. */
+static int
+startup_cache_load(const wchar_t *path, PyObject *key, PyObject *configDict)
+{
+    PyObject *cache = startup_cache_read(path);
+    if (cache == NULL) {
+        return -1;
+    }
+    int found = 0;
+    PyObject *entry = PyDict_GetItemWithError(cache, key);
+    if (entry != NULL && PyTuple_CheckExact(entry) && PyTuple_GET_SIZE(entry) == 2
+        && PyDict_CheckExact(PyTuple_GET_ITEM(entry, 1)))
+    {
+        PyObject *results = PyTuple_GET_ITEM(entry, 1);
+        PyObject *executable = PyDict_GetItemString(results, "executable");
+        if (executable == NULL) {
+            executable = PyDict_GetItemString(configDict, "executable");
+        }
+        PyObject *file_id = startup_cache_file_id(executable);
+        if (file_id == NULL) {
+            Py_DECREF(cache);
+            return -1;
+        }
+        if (file_id != Py_None) {
+            found = PyObject_RichCompareBool(file_id, PyTuple_GET_ITEM(entry, 0),
+                                             Py_EQ);
+        }
+        Py_DECREF(file_id);
+        if (found > 0 && PyDict_Update(configDict, results) < 0) {
+            found = -1;
+        }
+    }
+    else if (PyErr_Occurred()) {
+        found = -1;
+    }
+    Py_DECREF(cache);
+    return found;
+}
+
+
+/* Store the config fields that differ between before and configDict. */
+static int
+startup_cache_store(const wchar_t *path, PyObject *key, PyObject *before,
+                    PyObject *configDict)
+{
+    /* A ._pth file disables the environment, including this cache */
+    PyObject *use_environment = PyDict_GetItemString(configDict,
+                                                     "use_environment");
+    if (use_environment == NULL || !PyObject_IsTrue(use_environment)) {
+        return 0;
+    }
+    PyObject *file_id = startup_cache_file_id(
+        PyDict_GetItemString(configDict, "executable"));
+    if (file_id == NULL || file_id == Py_None) {
+        Py_XDECREF(file_id);
+        return file_id == NULL ? -1 : 0;
+    }
+    PyObject *results = PyDict_New();
+    if (results == NULL) {
+        Py_DECREF(file_id);
+        return -1;
+    }
+    Py_ssize_t pos = 0;
+    PyObject *name, *value;
+    while (PyDict_Next(configDict, &pos, &name, &value)) {
+        PyObject *old = PyDict_GetItemWithError(before, name);
+        int same = old != NULL ? PyObject_RichCompareBool(old, value, Py_EQ) : 0;
+        if (same < 0 || (!same && PyDict_SetItem(results, name, value) < 0)) {
+            Py_DECREF(file_id);
+            Py_DECREF(results);
+            return -1;
+        }
+    }
+    PyObject *entry = PyTuple_Pack(2, file_id, results);
+    Py_DECREF(file_id);
+    Py_DECREF(results);
+    if (entry == NULL) {
+        return -1;
+    }
+    /* Merge with the entries written by other processes in the meantime */
+    PyObject *cache = startup_cache_read(path);
+    if (cache == NULL) {
+        Py_DECREF(entry);
+        return -1;
+    }
+    if (PyDict_GET_SIZE(cache) >= STARTUP_CACHE_MAX_ENTRIES) {
+        PyDict_Clear(cache);
+    }
+    int r = PyDict_SetItem(cache, key, entry);
+    Py_DECREF(entry);
+    if (r == 0) {
+        startup_cache_write(path, cache);
+    }
+    Py_DECREF(cache);
+    return r;
+}
+
+
+/* Return a copy of configDict that getpath.py cannot modify in place. */
+static PyObject *
+startup_cache_copy_config(PyObject *configDict)
+{
+    PyObject *copy = PyDict_New();
+    if (copy == NULL) {
+        return NULL;
+    }
+    Py_ssize_t pos = 0;
+    PyObject *name, *value;
+    while (PyDict_Next(configDict, &pos, &name, &value)) {
+        PyObject *v = PyList_Check(value) ? PySequence_List(value)
+                                          : Py_NewRef(value);
+        if (v == NULL || PyDict_SetItem(copy, name, v) < 0) {
+            Py_XDECREF(v);
+            Py_DECREF(copy);
+            return NULL;
+        }
+        Py_DECREF(v);
+    }
+    return copy;
+}
+
+
 PyObject *
 _Py_Get_Getpath_CodeObject(void)
 {
@@ -890,6 +1218,7 @@ _PyConfig_InitPathConfig(PyConfig *config, int compute_path_config)
         !env_to_dict(dict, "ENV_PYTHONHOME", 0) ||
         !env_to_dict(dict, "ENV_PYTHONEXECUTABLE", 0) ||
         !env_to_dict(dict, "ENV___PYVENV_LAUNCHER__", 1) ||
+        !env_to_dict(dict, "ENV_PYTHONSTARTUPCACHE", 0) ||
         !progname_to_dict(dict, "real_executable") ||
         !library_to_dict(dict, "library") ||
         !wchar_to_dict(dict, "executable_dir", NULL) ||
@@ -906,15 +1235,49 @@ _PyConfig_InitPathConfig(PyConfig *config, int compute_path_config)
         return PyStatus_Error("error evaluating initial values");
     }
 
-    PyObject *r = PyEval_EvalCode(co, dict, dict);
-    Py_DECREF(co);
+    /* Reuse the results of an earlier run with the same inputs */
+    wchar_t *cache_file = startup_cache_file(dict, config);
+    PyObject *cache_key = NULL;
+    PyObject *before = NULL;
+    int cached = 0;
+    if (cache_file != NULL) {
+        cache_key = startup_cache_key(dict, configDict, config);
+        if (cache_key != NULL) {
+            cached = startup_cache_load(cache_file, cache_key, configDict);
+        }
+        if (!cached) {
+            before = startup_cache_copy_config(configDict);
+        }
+        if (cache_key == NULL || cached < 0 || (!cached && before == NULL)) {
+            /* The cache is only an optimization */
+            PyErr_Clear();
+            cached = 0;
+            Py_CLEAR(cache_key);
+        }
+    }
 
-    if (!r) {
-        Py_DECREF(dict);
-        _PyErr_WriteUnraisableMsg("error evaluating path", NULL);
-        return PyStatus_Error("error evaluating path");
+    if (!cached) {
+        PyObject *r = PyEval_EvalCode(co, dict, dict);
+        if (!r) {
+            Py_DECREF(co);
+            Py_DECREF(dict);
+            Py_XDECREF(cache_key);
+            Py_XDECREF(before);
+            PyMem_Free(cache_file);
+            _PyErr_WriteUnraisableMsg("error evaluating path", NULL);
+            return PyStatus_Error("error evaluating path");
+        }
+        Py_DECREF(r);
+        if (cache_key != NULL &&
+            startup_cache_store(cache_file, cache_key, before, configDict) < 0)
+        {
+            PyErr_Clear();
+        }
     }
-    Py_DECREF(r);
+    Py_DECREF(co);
+    Py_XDECREF(cache_key);
+    Py_XDECREF(before);
+    PyMem_Free(cache_file);
 
 #if 0
     PyObject *it = PyObject_GetIter(configDict);
@@ -29,6 +29,7 @@
 #include "pycore_fileutils.h"     // _Py_closerange()
 #include "pycore_import.h"        // _PyImport_ReInitLock()
 #include "pycore_initconfig.h"    // _PyStatus_EXCEPTION()
+#include "pycore_list.h"          // _PyList_AfterFork()
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
 #include "pycore_object.h"        // _PyObject_LookupSpecial()
 #include "pycore_pystate.h"       // _PyInterpreterState_GET()
@@ -631,6 +632,7 @@ PyOS_AfterFork_Child(void)
 
     _PySignal_AfterFork();
     _Py_queue_after_fork();
+    _PyList_AfterFork();
 
     PyThreadState *garbage = _PyThreadState_UnlinkExcept(runtime, tstate, 1);
 
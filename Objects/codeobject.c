@@ -361,7 +361,6 @@ _PyCode_Validate(struct _PyCodeConstructor *con)
     return 0;
 }
 
-extern void _PyCode_Quicken(PyCodeObject *code);
 
 static void
 init_code(PyCodeObject *co, struct _PyCodeConstructor *con)
@@ -418,7 +417,15 @@ init_code(PyCodeObject *co, struct _PyCodeConstructor *con)
         entry_point++;
     }
     co->_co_firsttraceable = entry_point;
-    _PyCode_Quicken(co);
+    if (entry_point < Py_SIZE(co)) {
+        /* Most code objects are never run (think of all the functions in
+         * a freshly unmarshalled module), so defer quickening until the
+         * entry RESUME is first executed. */
+        _PyCode_CODE(co)[entry_point].opcode = RESUME_QUICKEN;
+    }
+    else {
+        _PyCode_Quicken(co);
+    }
     notify_code_watchers(PY_CODE_EVENT_CREATE, co);
 }
 
@@ -2319,10 +2326,52 @@ _PyStaticCode_Init(PyCodeObject *co)
     if (res < 0) {
         return -1;
     }
+    if (co->co_version == 0) {
+        /* Deep-frozen outside the core (Tools/build/deepfreeze.py --app),
+           so it could not be given a version at build time. */
+        co->co_version = _Py_next_func_version;
+        if (_Py_next_func_version != 0) {
+            _Py_next_func_version++;
+        }
+    }
     _PyCode_Quicken(co);
     return 0;
 }
 
+int
+_PyStaticCode_InitSet(_PyStaticCodeSet *set)
+{
+    if (!_PyBeginOnce(&set->once)) {
+        return 0;
+    }
+    if (set->init() < 0) {
+        set->fini();
+        _PyEndOnceFailed(&set->once);
+        return -1;
+    }
+    _PyMutex_lock(&_PyRuntime.mutex);
+    set->next = _PyRuntime.static_code_sets;
+    _PyRuntime.static_code_sets = set;
+    _PyMutex_unlock(&_PyRuntime.mutex);
+    _PyEndOnce(&set->once);
+    return 0;
+}
+
+void
+_PyStaticCode_FiniSets(void)
+{
+    _PyStaticCodeSet *set = _PyRuntime.static_code_sets;
+    while (set != NULL) {
+        _PyStaticCodeSet *next = set->next;
+        set->fini();
+        set->next = NULL;
+        /* A later Py_Initialize() must initialize the set again. */
+        _Py_atomic_store_uintptr(&set->once.v, UNLOCKED);
+        set = next;
+    }
+    _PyRuntime.static_code_sets = NULL;
+}
+
 #define MAX_CODE_UNITS_PER_LOC_ENTRY 8
 
 PyCodeObject *
@@ -45,6 +45,9 @@ PyDictUnicodeEntry otherwise. Its length is USABLE_FRACTION(dk_size).
 NOTE: Since negative value is used for DKIX_EMPTY and DKIX_DUMMY, type of
 dk_indices entry is signed integer and int16 is used for table which
 dk_size == 256.
+
+In int32 tables, the bits of an index above log2(dk_size) hold a tag taken
+from the hash of the entry's key (see dictkeys_hash_tag()).
 */
 
 
@@ -119,6 +122,7 @@ As a consequence of this, split keys have a maximum size of 16.
 #include "pycore_dict.h"          // PyDictKeysObject
 #include "pycore_gc.h"            // _PyObject_GC_IS_TRACKED()
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
+#include "pycore_opcode.h"        // _PyOpcode_Deopt
 #include "pycore_pyerrors.h"      // _PyErr_Fetch()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "stringlib/eq.h"         // unicode_eq()
@@ -292,6 +296,64 @@ unicode_get_hash(PyObject *o)
     return _PyASCIIObject_CAST(o)->hash;
 }
 
+/* Only the owning thread writes its counters; the relaxed stores are for
+   sys._dict_layout_stats() reading them from another thread. */
+#define LAYOUT_STAT_ADD(name, n) \
+    do { \
+        Py_ssize_t *counter = &get_dict_thread_state()->layout_stats.name; \
+        _Py_atomic_store_ssize_relaxed(counter, *counter + (n)); \
+    } while (0)
+#define LAYOUT_STAT_INC(name) LAYOUT_STAT_ADD(name, 1)
+
+static void
+layout_stats_add(struct _Py_dict_layout_stats *total,
+                 struct _Py_dict_layout_stats *stats)
+{
+    total->unshared += _Py_atomic_load_ssize_relaxed(&stats->unshared);
+    total->unshared_keys_full +=
+        _Py_atomic_load_ssize_relaxed(&stats->unshared_keys_full);
+    total->unshared_incompatible_key +=
+        _Py_atomic_load_ssize_relaxed(&stats->unshared_incompatible_key);
+    total->materialized += _Py_atomic_load_ssize_relaxed(&stats->materialized);
+    total->prepopulated_keys +=
+        _Py_atomic_load_ssize_relaxed(&stats->prepopulated_keys);
+}
+
+/* Add the layout stats of tstate, which is exiting, to its interpreter's.
+   Called with HEAD_LOCK held. */
+void
+_PyDict_MergeLayoutStats(PyThreadState *tstate)
+{
+    struct _Py_dict_layout_stats *stats =
+        &((PyThreadStateImpl *)tstate)->dict_state.layout_stats;
+    layout_stats_add(&tstate->interp->dict_state.layout_stats, stats);
+    memset(stats, 0, sizeof(*stats));
+}
+
+PyObject *
+_PyDict_GetLayoutStats(void)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    _PyRuntimeState *runtime = interp->runtime;
+    struct _Py_dict_layout_stats total;
+
+    HEAD_LOCK(runtime);
+    total = interp->dict_state.layout_stats;
+    for (PyThreadState *p = interp->threads.head; p != NULL; p = p->next) {
+        layout_stats_add(&total,
+                         &((PyThreadStateImpl *)p)->dict_state.layout_stats);
+    }
+    HEAD_UNLOCK(runtime);
+
+    return Py_BuildValue(
+        "{sn sn sn sn sn}",
+        "unshared", total.unshared,
+        "unshared_keys_full", total.unshared_keys_full,
+        "unshared_incompatible_key", total.unshared_incompatible_key,
+        "materialized", total.materialized,
+        "prepopulated_keys", total.prepopulated_keys);
+}
+
 /* Print summary info about the state of the optimized allocator */
 void
 _PyDict_DebugMallocStats(FILE *out)
@@ -368,6 +430,52 @@ dictkeys_set_index(PyDictKeysObject *keys, Py_ssize_t i, Py_ssize_t ix)
     }
 }
 
+/* Tables with 32-bit indices (from DICT_TAG_LOG2_MINSIZE up) keep the bits
+   of the hash just above the ones selecting the first probe in the high bits
+   of each index slot that the entry position leaves unused.  Most probes for
+   other keys are then rejected on those bits without loading the entry,
+   which in a table this large is usually a cache miss.  Smaller tables are
+   left alone: their entries are likely to be cached already, and their
+   lookups are on the interpreter's hot paths. */
+#define DICT_TAG_LOG2_MINSIZE 16
+
+static inline Py_ssize_t
+dictkeys_hash_tag(const PyDictKeysObject *keys, Py_hash_t hash)
+{
+    int log2size = DK_LOG_SIZE(keys);
+    if (log2size < DICT_TAG_LOG2_MINSIZE || log2size >= 32) {
+        return 0;
+    }
+    size_t tag_mask = ((size_t)1 << (31 - log2size)) - 1;
+    return (Py_ssize_t)((((size_t)hash >> log2size) & tag_mask) << log2size);
+}
+
+/* Like dictkeys_get_index(), for probing for a key with the given tag: an
+   index slot whose tag does not match is reported as DKIX_DUMMY. */
+static inline Py_ssize_t
+dictkeys_probe_index(const PyDictKeysObject *keys, Py_ssize_t i,
+                     Py_ssize_t tag)
+{
+    Py_ssize_t ix = dictkeys_get_index(keys, i);
+    if (ix >= 0) {
+        Py_ssize_t mask = (Py_ssize_t)DK_SIZE(keys) - 1;
+        if ((ix & ~mask) != tag) {
+            return DKIX_DUMMY;
+        }
+        ix &= mask;
+    }
+    return ix;
+}
+
+/* Make index slot i refer to entry ix, whose key has the given hash. */
+static inline void
+dictkeys_set_entry_index(PyDictKeysObject *keys, Py_ssize_t i, Py_ssize_t ix,
+                         Py_hash_t hash)
+{
+    assert(ix >= 0);
+    dictkeys_set_index(keys, i, ix | dictkeys_hash_tag(keys, hash));
+}
+
 
 /* USABLE_FRACTION is the maximum dictionary load.
  * Increasing this ratio makes dictionaries more dense resulting in more
@@ -429,6 +537,102 @@ estimate_log2_keysize(Py_ssize_t n)
  */
 #define GROWTH_RATE(d) ((d)->ma_used*3)
 
+/* Incremental resizing of large tables.
+ *
+ * Growing a combined table of DICT_INCREMENTAL_MINSIZE slots or more does
+ * not rehash every entry at once.  dictresize() publishes the new keys object
+ * right away and keeps the old one alive; each later update, locked lookup or
+ * locked iteration step of the dict then moves DICT_RESIZE_STEP entries
+ * across (see dict_resize_step()).  Entries keep their position, so entry i
+ * lives either in the old table or in the new one, and lookups that miss in
+ * the new table try the old table too.  Lock-free readers take the locked
+ * path while a resize is pending, so a dict that is only read after growing
+ * still finishes migrating after about dk_nentries / DICT_RESIZE_STEP reads.
+ *
+ * The bookkeeping lives in a small trailer after the entries array, which
+ * only tables large enough to be resized incrementally have.
+ */
+#define DICT_INCREMENTAL_LOG2_MINSIZE 17
+#define DICT_INCREMENTAL_MINSIZE (((Py_ssize_t)1) << DICT_INCREMENTAL_LOG2_MINSIZE)
+#define DICT_RESIZE_STEP 64
+
+static void dict_resize_step(PyDictObject *mp, Py_ssize_t n);
+
+typedef struct {
+    /* Table being migrated into this one, or NULL. */
+    PyDictKeysObject *oldkeys;
+    /* Entries of oldkeys before this position have been moved. */
+    Py_ssize_t next;
+} _PyDictResizeState;
+
+static inline int
+dictkeys_has_resize_state(PyDictKeysObject *dk)
+{
+    return (DK_LOG_SIZE(dk) >= DICT_INCREMENTAL_LOG2_MINSIZE &&
+            dk->dk_kind != DICT_KEYS_SPLIT);
+}
+
+static inline _PyDictResizeState *
+dictkeys_resize_state(PyDictKeysObject *dk)
+{
+    assert(dictkeys_has_resize_state(dk));
+    size_t es = (dk->dk_kind == DICT_KEYS_GENERAL
+                 ? sizeof(PyDictKeyEntry) : sizeof(PyDictUnicodeEntry));
+    return (_PyDictResizeState *)((char *)_DK_ENTRIES(dk) +
+                                  es * USABLE_FRACTION((size_t)DK_SIZE(dk)));
+}
+
+/* Return the table dk is still being migrated from, or NULL. */
+static inline PyDictKeysObject *
+dictkeys_oldkeys(PyDictKeysObject *dk)
+{
+    if (!dictkeys_has_resize_state(dk)) {
+        return NULL;
+    }
+    return _Py_atomic_load_ptr(&dictkeys_resize_state(dk)->oldkeys);
+}
+
+/* Read entry ix of a combined table that is being resized incrementally:
+   entries that were not moved yet are still in the old table.  Return the
+   value (a borrowed reference), or NULL for an unused entry.  The dict must
+   be locked. */
+static PyObject *
+dictkeys_get_entry(PyDictKeysObject *dk, PyDictKeysObject *old, Py_ssize_t ix,
+                   PyObject **pkey, Py_hash_t *phash)
+{
+    assert(old != NULL);
+    PyDictKeysObject *k = dk;
+    if (ix < old->dk_nentries) {
+        PyObject *key = (DK_IS_UNICODE(dk) ? DK_UNICODE_ENTRIES(dk)[ix].me_key
+                                           : DK_ENTRIES(dk)[ix].me_key);
+        if (key == NULL) {
+            k = old;
+        }
+    }
+    if (DK_IS_UNICODE(k)) {
+        PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(k)[ix];
+        if (ep->me_value == NULL) {
+            return NULL;
+        }
+        *pkey = ep->me_key;
+        if (phash) {
+            *phash = unicode_get_hash(ep->me_key);
+        }
+        return ep->me_value;
+    }
+    else {
+        PyDictKeyEntry *ep = &DK_ENTRIES(k)[ix];
+        if (ep->me_value == NULL) {
+            return NULL;
+        }
+        *pkey = ep->me_key;
+        if (phash) {
+            *phash = ep->me_hash;
+        }
+        return ep->me_value;
+    }
+}
+
 /* This immutable, empty PyDictKeysObject is used for PyDict_Clear()
  * (which cannot fail and thus can do no allocation).
  */
@@ -517,12 +721,15 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
     if (check_content) {
         for (Py_ssize_t i=0; i < DK_SIZE(keys); i++) {
             Py_ssize_t ix = dictkeys_get_index(keys, i);
+            if (ix >= 0) {
+                ix &= DK_MASK(keys);
+            }
             CHECK(DKIX_DUMMY <= ix && ix <= usable);
         }
 
         if (keys->dk_kind == DICT_KEYS_GENERAL) {
             PyDictKeyEntry *entries = DK_ENTRIES(keys);
-            for (Py_ssize_t i=0; i < usable; i++) {
+            for (Py_ssize_t i=0; i < keys->dk_nentries; i++) {
                 PyDictKeyEntry *entry = &entries[i];
                 PyObject *key = entry->me_key;
 
@@ -540,7 +747,7 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
         }
         else {
             PyDictUnicodeEntry *entries = DK_UNICODE_ENTRIES(keys);
-            for (Py_ssize_t i=0; i < usable; i++) {
+            for (Py_ssize_t i=0; i < keys->dk_nentries; i++) {
                 PyDictUnicodeEntry *entry = &entries[i];
                 PyObject *key = entry->me_key;
 
@@ -598,6 +805,7 @@ _PyDict_NewKeysForClass(void)
     }
     shared->tracked = 0;
     shared->marked = 0;
+    shared->prepopulated = 0;
     shared->next = NULL;
 
     PyDictKeysObject *dk = &shared->keys;
@@ -652,13 +860,21 @@ new_keys_object(uint8_t log2_size, bool unicode)
     else
 #endif
     {
+        /* Large tables get the incremental resize trailer. */
+        size_t trailer = (log2_size >= DICT_INCREMENTAL_LOG2_MINSIZE
+                          ? sizeof(_PyDictResizeState) : 0);
         dk = PyMem_Malloc(sizeof(PyDictKeysObject)
                           + ((size_t)1 << log2_bytes)
-                          + entry_size * usable);
+                          + entry_size * usable
+                          + trailer);
         if (dk == NULL) {
             PyErr_NoMemory();
             return NULL;
         }
+        if (trailer) {
+            memset((char *)&dk->dk_indices[(size_t)1 << log2_bytes]
+                   + entry_size * usable, 0, trailer);
+        }
     }
 #ifdef Py_REF_DEBUG
     // _Py_IncRefTotal();
@@ -671,7 +887,11 @@ new_keys_object(uint8_t log2_size, bool unicode)
     dk->dk_usable = usable;
     dk->dk_version = 0;
     memset(&dk->dk_indices[0], 0xff, ((size_t)1 << log2_bytes));
-    memset(&dk->dk_indices[(size_t)1 << log2_bytes], 0, entry_size * usable);
+    if (log2_size < DICT_INCREMENTAL_LOG2_MINSIZE) {
+        memset(&dk->dk_indices[(size_t)1 << log2_bytes], 0, entry_size * usable);
+    }
+    /* Entries of large tables are only initialized when used: touching
+       all of them up front would dominate the cost of a resize. */
     return dk;
 }
 
@@ -682,6 +902,11 @@ free_keys_object(PyDictKeysObject *keys, bool use_qsbr)
 #ifdef Py_REF_DEBUG
     // _Py_DecRefTotal();
 #endif
+    PyDictKeysObject *oldkeys = dictkeys_oldkeys(keys);
+    if (oldkeys != NULL) {
+        /* Entries that were not moved yet are still owned by oldkeys */
+        free_keys_object(oldkeys, use_qsbr);
+    }
     if (keys->dk_kind == DICT_KEYS_UNICODE) {
         PyDictUnicodeEntry *entries = DK_UNICODE_ENTRIES(keys);
         Py_ssize_t i, n;
@@ -829,6 +1054,7 @@ clone_combined_dict_keys(PyDictObject *orig)
     assert(PyDict_Check(orig));
     assert(Py_TYPE(orig)->tp_iter == (getiterfunc)dict_iter);
     assert(orig->ma_values == NULL);
+    assert(dictkeys_oldkeys(orig->ma_keys) == NULL);
 
     size_t keys_size = _PyDict_KeysSize(orig->ma_keys);
     PyDictKeysObject *keys = PyMem_Malloc(keys_size);
@@ -883,9 +1109,10 @@ lookdict_index(PyDictKeysObject *k, Py_hash_t hash, Py_ssize_t index)
     size_t mask = DK_MASK(k);
     size_t perturb = (size_t)hash;
     size_t i = (size_t)hash & mask;
+    Py_ssize_t tag = dictkeys_hash_tag(k, hash);
 
     for (;;) {
-        Py_ssize_t ix = dictkeys_get_index(k, i);
+        Py_ssize_t ix = dictkeys_probe_index(k, i, tag);
         if (ix == index) {
             return i;
         }
@@ -906,9 +1133,10 @@ unicodekeys_lookup_generic(PyDictObject *mp, PyDictKeysObject* dk, PyObject *key
     size_t mask = DK_MASK(dk);
     size_t perturb = hash;
     size_t i = (size_t)hash & mask;
+    Py_ssize_t tag = dictkeys_hash_tag(dk, hash);
     Py_ssize_t ix;
     for (;;) {
-        ix = dictkeys_get_index(dk, i);
+        ix = dictkeys_probe_index(dk, i, tag);
         if (ix >= 0) {
             PyDictUnicodeEntry *ep = &ep0[ix];
             assert(ep->me_key != NULL);
@@ -952,9 +1180,10 @@ unicodekeys_lookup_unicode(PyDictKeysObject* dk, PyObject *key, Py_hash_t hash)
     size_t mask = DK_MASK(dk);
     size_t perturb = hash;
     size_t i = (size_t)hash & mask;
+    Py_ssize_t tag = dictkeys_hash_tag(dk, hash);
     Py_ssize_t ix;
     for (;;) {
-        ix = dictkeys_get_index(dk, i);
+        ix = dictkeys_probe_index(dk, i, tag);
         if (ix >= 0) {
             PyDictUnicodeEntry *ep = &ep0[ix];
             assert(ep->me_key != NULL);
@@ -969,7 +1198,7 @@ unicodekeys_lookup_unicode(PyDictKeysObject* dk, PyObject *key, Py_hash_t hash)
         }
         perturb >>= PERTURB_SHIFT;
         i = mask & (i*5 + perturb + 1);
-        ix = dictkeys_get_index(dk, i);
+        ix = dictkeys_probe_index(dk, i, tag);
         if (ix >= 0) {
             PyDictUnicodeEntry *ep = &ep0[ix];
             assert(ep->me_key != NULL);
@@ -995,9 +1224,10 @@ unicodekeys_lookup_unicode_ts(PyDictKeysObject* dk, PyObject *key, Py_hash_t has
     size_t mask = DK_MASK(dk);
     size_t perturb = hash;
     size_t i = (size_t)hash & mask;
+    Py_ssize_t tag = dictkeys_hash_tag(dk, hash);
     Py_ssize_t ix;
     for (;;) {
-        ix = dictkeys_get_index(dk, i);
+        ix = dictkeys_probe_index(dk, i, tag);
         if (ix >= 0) {
             PyObject *ep_key = _Py_atomic_load_ptr_relaxed(&ep0[ix].me_key);
             if (ep_key == key) {
@@ -1015,7 +1245,7 @@ unicodekeys_lookup_unicode_ts(PyDictKeysObject* dk, PyObject *key, Py_hash_t has
         }
         perturb >>= PERTURB_SHIFT;
         i = mask & (i*5 + perturb + 1);
-        ix = dictkeys_get_index(dk, i);
+        ix = dictkeys_probe_index(dk, i, tag);
         if (ix >= 0) {
             PyObject *ep_key = _Py_atomic_load_ptr_relaxed(&ep0[ix].me_key);
             if (ep_key == key) {
@@ -1044,9 +1274,10 @@ dictkeys_generic_lookup_ts(PyDictObject *mp, PyDictKeysObject* dk, PyObject *key
     size_t mask = DK_MASK(dk);
     size_t perturb = hash;
     size_t i = (size_t)hash & mask;
+    Py_ssize_t tag = dictkeys_hash_tag(dk, hash);
     Py_ssize_t ix;
     for (;;) {
-        ix = dictkeys_get_index(dk, i);
+        ix = dictkeys_probe_index(dk, i, tag);
         if (ix >= 0) {
             PyObject *ep_key = _Py_atomic_load_ptr_relaxed(&ep0[ix].me_key);
             if (ep_key == key) {
@@ -1092,9 +1323,10 @@ dictkeys_generic_lookup(PyDictObject *mp, PyDictKeysObject* dk, PyObject *key, P
     size_t mask = DK_MASK(dk);
     size_t perturb = hash;
     size_t i = (size_t)hash & mask;
+    Py_ssize_t tag = dictkeys_hash_tag(dk, hash);
     Py_ssize_t ix;
     for (;;) {
-        ix = dictkeys_get_index(dk, i);
+        ix = dictkeys_probe_index(dk, i, tag);
         if (ix >= 0) {
             PyDictKeyEntry *ep = &ep0[ix];
             assert(ep->me_key != NULL);
@@ -1129,6 +1361,75 @@ dictkeys_generic_lookup(PyDictObject *mp, PyDictKeysObject* dk, PyObject *key, P
     Py_UNREACHABLE();
 }
 
+/* Search the table a large dict is being migrated from (see
+ * dict_resize_step()).  Moved entries leave their key NULL behind, and a rich
+ * comparison may run arbitrary code, so this is careful in the same way as
+ * the _ts variants above.
+ */
+static Py_ssize_t
+oldkeys_lookup(PyDictObject *mp, PyDictKeysObject *old, PyObject *key, Py_hash_t hash)
+{
+    if (DK_IS_UNICODE(old) && PyUnicode_CheckExact(key)) {
+        return unicodekeys_lookup_unicode_ts(old, key, hash);
+    }
+    size_t mask = DK_MASK(old);
+    size_t perturb = hash;
+    size_t i = (size_t)hash & mask;
+    Py_ssize_t tag = dictkeys_hash_tag(old, hash);
+    Py_ssize_t ix;
+    for (;;) {
+        ix = dictkeys_probe_index(old, i, tag);
+        if (ix >= 0) {
+            PyObject **keyptr;
+            Py_hash_t ep_hash;
+            if (DK_IS_UNICODE(old)) {
+                keyptr = &DK_UNICODE_ENTRIES(old)[ix].me_key;
+            }
+            else {
+                keyptr = &DK_ENTRIES(old)[ix].me_key;
+            }
+            PyObject *ep_key = _Py_atomic_load_ptr(keyptr);
+            if (ep_key == key) {
+                return ix;
+            }
+            if (ep_key != NULL) {
+                if (DK_IS_UNICODE(old)) {
+                    ep_hash = unicode_get_hash(ep_key);
+                }
+                else {
+                    ep_hash = _Py_atomic_load_ssize_relaxed(&DK_ENTRIES(old)[ix].me_hash);
+                }
+                if (ep_hash == hash) {
+                    Py_INCREF(ep_key);
+                    int cmp = PyObject_RichCompareBool(ep_key, key, Py_EQ);
+                    PyDictKeysObject *dk = _Py_atomic_load_ptr(&mp->ma_keys);
+                    bool unmodified = (old == dictkeys_oldkeys(dk) &&
+                                       ep_key == _Py_atomic_load_ptr(keyptr));
+                    Py_DECREF(ep_key);
+                    if (cmp < 0) {
+                        return DKIX_ERROR;
+                    }
+                    if (unmodified) {
+                        if (cmp > 0) {
+                            return ix;
+                        }
+                    }
+                    else {
+                        /* The dict was mutated, restart */
+                        return DKIX_KEY_CHANGED;
+                    }
+                }
+            }
+        }
+        else if (ix == DKIX_EMPTY) {
+            return DKIX_EMPTY;
+        }
+        perturb >>= PERTURB_SHIFT;
+        i = mask & (i*5 + perturb + 1);
+    }
+    Py_UNREACHABLE();
+}
+
 /* Lookup a string in a (all unicode) dict keys.
  * Returns DKIX_ERROR if key is not a string,
  * or if the dict keys is not all strings.
@@ -1150,7 +1451,15 @@ _PyDictKeys_StringLookup(PyDictKeysObject* dk, PyObject *key)
             return DKIX_ERROR;
         }
     }
-    return unicodekeys_lookup_unicode(dk, key, hash);
+    Py_ssize_t ix = unicodekeys_lookup_unicode(dk, key, hash);
+    if (ix == DKIX_EMPTY) {
+        /* Entries keep their index when they are moved */
+        PyDictKeysObject *old = dictkeys_oldkeys(dk);
+        if (old != NULL) {
+            ix = unicodekeys_lookup_unicode_ts(old, key, hash);
+        }
+    }
+    return ix;
 }
 
 /*
@@ -1215,6 +1524,24 @@ _Py_dict_lookup(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject **valu
         }
     }
 
+    if (ix == DKIX_EMPTY) {
+        PyDictKeysObject *old = dictkeys_oldkeys(dk);
+        if (old != NULL) {
+            ix = oldkeys_lookup(mp, old, key, hash);
+            if (ix == DKIX_KEY_CHANGED) {
+                goto start;
+            }
+            if (ix >= 0) {
+                if (DK_IS_UNICODE(old)) {
+                    *value_addr = DK_UNICODE_ENTRIES(old)[ix].me_value;
+                }
+                else {
+                    *value_addr = DK_ENTRIES(old)[ix].me_value;
+                }
+            }
+        }
+    }
+
     return ix;
 }
 
@@ -1226,6 +1553,7 @@ _Py_dict_fetch_locked(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject
     if (!_PyObject_GC_IS_SHARED(mp)) {
         _PyObject_GC_SET_SHARED(mp);
     }
+    dict_resize_step(mp, DICT_RESIZE_STEP);
     ix = _Py_dict_lookup(mp, key, hash, value_addr);
     if (*value_addr) {
         PyObject *value = *value_addr;
@@ -1257,6 +1585,10 @@ _Py_dict_fetch(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject **value
     }
 
     dk = _Py_atomic_load_ptr(&mp->ma_keys);
+    if (dictkeys_oldkeys(dk) != NULL) {
+        /* Finish the pending resize rather than searching both tables */
+        return _Py_dict_fetch_locked(mp, key, hash, value_addr);
+    }
     kind = dk->dk_kind;
 
     if (kind != DICT_KEYS_GENERAL) {
@@ -1385,6 +1717,10 @@ _PyDict_MaybeUntrack(PyObject *op)
         }
     }
     else {
+        if (dictkeys_oldkeys(mp->ma_keys) != NULL) {
+            /* Incremental resize in progress */
+            return;
+        }
         if (DK_IS_UNICODE(mp->ma_keys)) {
             PyDictUnicodeEntry *ep0 = DK_UNICODE_ENTRIES(mp->ma_keys);
             for (i = 0; i < numentries; i++) {
@@ -1428,6 +1764,101 @@ find_empty_slot(PyDictKeysObject *keys, Py_hash_t hash)
     return i;
 }
 
+/* Move entry ix of the old table into the same position of dk.  The
+   references are transferred: the old entry is left empty. */
+static void
+dictkeys_move_entry(PyDictKeysObject *dk, PyDictKeysObject *old, Py_ssize_t ix)
+{
+    Py_hash_t hash;
+    if (DK_IS_UNICODE(old)) {
+        PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(old)[ix];
+        PyObject *key = ep->me_key;
+        if (key == NULL) {
+            return;
+        }
+        PyDictUnicodeEntry *newep = &DK_UNICODE_ENTRIES(dk)[ix];
+        assert(newep->me_key == NULL);
+        _Py_atomic_store_ptr_relaxed(&newep->me_key, key);
+        _Py_atomic_store_ptr_relaxed(&newep->me_value, ep->me_value);
+        hash = unicode_get_hash(key);
+        dk->dk_version = 0;
+        dictkeys_set_entry_index(dk, find_empty_slot(dk, hash), ix, hash);
+        _Py_atomic_store_ptr(&ep->me_value, NULL);
+        _Py_atomic_store_ptr(&ep->me_key, NULL);
+    }
+    else {
+        PyDictKeyEntry *ep = &DK_ENTRIES(old)[ix];
+        PyObject *key = ep->me_key;
+        if (key == NULL) {
+            return;
+        }
+        PyDictKeyEntry *newep = &DK_ENTRIES(dk)[ix];
+        assert(newep->me_key == NULL);
+        hash = ep->me_hash;
+        _Py_atomic_store_ptr_relaxed(&newep->me_key, key);
+        _Py_atomic_store_ssize_relaxed(&newep->me_hash, hash);
+        _Py_atomic_store_ptr_relaxed(&newep->me_value, ep->me_value);
+        dk->dk_version = 0;
+        dictkeys_set_entry_index(dk, find_empty_slot(dk, hash), ix, hash);
+        _Py_atomic_store_ptr(&ep->me_value, NULL);
+        _Py_atomic_store_ptr(&ep->me_key, NULL);
+    }
+}
+
+/* Move up to n more entries of a pending incremental resize, and release
+   the old table once it is empty.  The dict must be locked. */
+static void
+dict_resize_step(PyDictObject *mp, Py_ssize_t n)
+{
+    PyDictKeysObject *dk = mp->ma_keys;
+    PyDictKeysObject *old = dictkeys_oldkeys(dk);
+    if (old == NULL) {
+        return;
+    }
+    _PyDictResizeState *state = dictkeys_resize_state(dk);
+    Py_ssize_t i = state->next;
+    Py_ssize_t end = old->dk_nentries;
+    if (n < end - i) {
+        end = i + n;
+    }
+    for (; i < end; i++) {
+        dictkeys_move_entry(dk, old, i);
+    }
+    state->next = end;
+    if (end == old->dk_nentries) {
+        _Py_atomic_store_ptr(&state->oldkeys, NULL);
+        /* Every entry has been moved: nothing left to decref */
+        old->dk_nentries = 0;
+        free_keys_object(old, _PyObject_GC_IS_SHARED(mp));
+    }
+}
+
+static void
+dict_finish_resize(PyDictObject *mp)
+{
+    dict_resize_step(mp, PY_SSIZE_T_MAX);
+}
+
+/* Like _Py_dict_lookup(), for callers that go on to modify the entry:
+   advance a pending incremental resize, and make sure the entry found has
+   been moved into mp->ma_keys. */
+static Py_ssize_t
+dict_lookup_for_update(PyDictObject *mp, PyObject *key, Py_hash_t hash,
+                       PyObject **value_addr)
+{
+    if (dictkeys_oldkeys(mp->ma_keys) != NULL) {
+        dict_resize_step(mp, DICT_RESIZE_STEP);
+    }
+    Py_ssize_t ix = _Py_dict_lookup(mp, key, hash, value_addr);
+    if (ix >= 0) {
+        PyDictKeysObject *old = dictkeys_oldkeys(mp->ma_keys);
+        if (old != NULL && ix < old->dk_nentries) {
+            dictkeys_move_entry(mp->ma_keys, old, ix);
+        }
+    }
+    return ix;
+}
+
 static int
 insertion_resize(PyDictObject *mp, int unicode)
 {
@@ -1451,7 +1882,7 @@ insert_into_dictkeys(PyDictKeysObject *keys, PyObject *name)
         Py_ssize_t hashpos = find_empty_slot(keys, hash);
         ix = keys->dk_nentries;
         PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(keys)[ix];
-        dictkeys_set_index(keys, hashpos, ix);
+        dictkeys_set_entry_index(keys, hashpos, ix, hash);
         assert(ep->me_key == NULL);
         ep->me_key = Py_NewRef(name);
         _Py_atomic_store_ssize_relaxed(&keys->dk_usable, keys->dk_usable - 1);
@@ -1517,6 +1948,9 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
     PyObject *old_value;
 
     if (!compatible_key(mp->ma_keys, key)) {
+        if (mp->ma_values != NULL) {
+            LAYOUT_STAT_INC(unshared_incompatible_key);
+        }
         if (insertion_resize(mp, 0) < 0)
             goto Fail;
         assert(mp->ma_keys->dk_kind == DICT_KEYS_GENERAL);
@@ -1528,11 +1962,12 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
             return insert_into_dictvalues(mp, key, value, ix);
         }
         /* No space in shared keys. Resize and continue below. */
+        LAYOUT_STAT_INC(unshared_keys_full);
         if (insertion_resize(mp, 1) < 0)
             goto Fail;
     }
 
-    Py_ssize_t ix = _Py_dict_lookup(mp, key, hash, &old_value);
+    Py_ssize_t ix = dict_lookup_for_update(mp, key, hash, &old_value);
     if (ix == DKIX_ERROR)
         goto Fail;
 
@@ -1550,7 +1985,8 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
         }
 
         Py_ssize_t hashpos = find_empty_slot(mp->ma_keys, hash);
-        dictkeys_set_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries);
+        dictkeys_set_entry_index(mp->ma_keys, hashpos,
+                                 mp->ma_keys->dk_nentries, hash);
 
         if (DK_IS_UNICODE(mp->ma_keys)) {
             PyDictUnicodeEntry *ep;
@@ -1653,7 +2089,7 @@ build_indices_generic(PyDictKeysObject *keys, PyDictKeyEntry *ep, Py_ssize_t n)
             perturb >>= PERTURB_SHIFT;
             i = mask & (i*5 + perturb + 1);
         }
-        dictkeys_set_index(keys, i, ix);
+        dictkeys_set_entry_index(keys, i, ix, hash);
     }
 }
 
@@ -1669,7 +2105,7 @@ build_indices_unicode(PyDictKeysObject *keys, PyDictUnicodeEntry *ep, Py_ssize_t
             perturb >>= PERTURB_SHIFT;
             i = mask & (i*5 + perturb + 1);
         }
-        dictkeys_set_index(keys, i, ix);
+        dictkeys_set_entry_index(keys, i, ix, hash);
     }
 }
 
@@ -1699,12 +2135,18 @@ dictresize(PyDictObject *mp, uint8_t log2_newsize, int unicode)
     }
     assert(log2_newsize >= PyDict_LOG_MINSIZE);
 
+    /* Complete a pending incremental resize first */
+    dict_finish_resize(mp);
+
     oldkeys = mp->ma_keys;
     oldvalues = mp->ma_values;
 
     if (!DK_IS_UNICODE(oldkeys)) {
         unicode = 0;
     }
+    if (oldvalues != NULL) {
+        LAYOUT_STAT_INC(unshared);
+    }
 
     /* NOTE: Current odict checks mp->ma_keys to detect resize happen.
      * So we can't reuse oldkeys even if oldkeys->dk_size == newsize.
@@ -1719,6 +2161,30 @@ dictresize(PyDictObject *mp, uint8_t log2_newsize, int unicode)
     // New table must be large enough.
     assert(newkeys->dk_usable >= mp->ma_used);
 
+    if (oldvalues == NULL && oldkeys != Py_EMPTY_KEYS &&
+            dictkeys_has_resize_state(newkeys) &&
+            DK_LOG_SIZE(newkeys) > DK_LOG_SIZE(oldkeys) &&
+            DK_IS_UNICODE(newkeys) == DK_IS_UNICODE(oldkeys) &&
+            newkeys->dk_usable - oldkeys->dk_nentries >= mp->ma_used) {
+        /* Growing a large combined table: keep every entry at its position
+           and let later updates move them over in batches. */
+        _PyDictResizeState *state = dictkeys_resize_state(newkeys);
+        /* Entries that are still in the old table read as empty */
+        memset(DK_IS_UNICODE(newkeys) ? (void *)DK_UNICODE_ENTRIES(newkeys)
+                                      : (void *)DK_ENTRIES(newkeys), 0,
+               oldkeys->dk_nentries * (DK_IS_UNICODE(newkeys)
+                                       ? sizeof(PyDictUnicodeEntry)
+                                       : sizeof(PyDictKeyEntry)));
+        state->oldkeys = oldkeys;
+        state->next = 0;
+        newkeys->dk_usable -= oldkeys->dk_nentries;
+        newkeys->dk_nentries = oldkeys->dk_nentries;
+        _Py_atomic_store_ptr_release(&mp->ma_keys, newkeys);
+        dict_resize_step(mp, DICT_RESIZE_STEP);
+        ASSERT_CONSISTENT(mp);
+        return 0;
+    }
+
     Py_ssize_t numentries = mp->ma_used;
 
     if (oldvalues != NULL) {
@@ -1949,6 +2415,20 @@ PyDict_FetchItemWithError(PyObject *op, PyObject *key)
     return value;
 }
 
+/* Same as PyDict_FetchItemWithError() but with hash supplied by caller.
+   The lookup does not lock the dict if it is marked as shared. */
+PyObject *
+_PyDict_FetchItem_KnownHash(PyObject *op, PyObject *key, Py_hash_t hash)
+{
+    Py_ssize_t ix; (void)ix;
+    PyObject *value;
+
+    assert(PyDict_Check(op));
+    ix = _Py_dict_fetch((PyDictObject *)op, key, hash, &value);
+    assert(ix >= 0 || value == NULL);
+    return value;
+}
+
 PyObject *
 PyDict_FetchItemString(PyObject *v, const char *key)
 {
@@ -2318,7 +2798,7 @@ _PyDict_DelItem_KnownHash(PyObject *op, PyObject *key, Py_hash_t hash)
     assert(hash != -1);
     mp = (PyDictObject *)op;
     Py_BEGIN_CRITICAL_SECTION(mp);
-    ix = _Py_dict_lookup(mp, key, hash, &old_value);
+    ix = dict_lookup_for_update(mp, key, hash, &old_value);
     if (ix == DKIX_ERROR) {
         err = -1;
     }
@@ -2342,7 +2822,7 @@ _PyDict_DelItemIf_KnownHash(PyDictObject *mp, PyObject *key, Py_hash_t hash,
 {
     PyObject *old_value;
 
-    Py_ssize_t ix = _Py_dict_lookup(mp, key, hash, &old_value);
+    Py_ssize_t ix = dict_lookup_for_update(mp, key, hash, &old_value);
     if (ix == DKIX_ERROR)
         return -1;
     if (ix == DKIX_EMPTY || old_value == NULL) {
@@ -2354,12 +2834,9 @@ _PyDict_DelItemIf_KnownHash(PyDictObject *mp, PyObject *key, Py_hash_t hash,
     if (res == -1)
         return -1;
 
-    Py_ssize_t hashpos = lookdict_index(mp->ma_keys, hash, ix);
-    assert(hashpos >= 0);
-
     if (res > 0) {
         uint64_t new_version = _PyDict_NotifyEvent(PyDict_EVENT_DELETED, mp, key, NULL);
-        return delitem_common(mp, hashpos, ix, old_value, new_version);
+        return delitem_common(mp, hash, ix, old_value, new_version);
     } else {
         return 0;
     }
@@ -2469,7 +2946,15 @@ _PyDict_Next(PyObject *op, Py_ssize_t *ppos, PyObject **pkey,
         Py_ssize_t n = mp->ma_keys->dk_nentries;
         if (i < 0 || i >= n)
             return 0;
-        if (DK_IS_UNICODE(mp->ma_keys)) {
+        PyDictKeysObject *oldkeys = dictkeys_oldkeys(mp->ma_keys);
+        if (oldkeys != NULL) {
+            while ((value = dictkeys_get_entry(mp->ma_keys, oldkeys, i,
+                                               &key, &hash)) == NULL) {
+                if (++i >= n)
+                    return 0;
+            }
+        }
+        else if (DK_IS_UNICODE(mp->ma_keys)) {
             PyDictUnicodeEntry *entry_ptr = &DK_UNICODE_ENTRIES(mp->ma_keys)[i];
             while (i < n && entry_ptr->me_value == NULL) {
                 entry_ptr++;
@@ -2539,7 +3024,7 @@ dict_pop_known_hash_locked(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyOb
         return NULL;
     }
     PyObject *old_value;
-    Py_ssize_t ix = _Py_dict_lookup(mp, key, hash, &old_value);
+    Py_ssize_t ix = dict_lookup_for_update(mp, key, hash, &old_value);
     if (ix == DKIX_ERROR)
         return NULL;
     if (ix == DKIX_EMPTY || old_value == NULL) {
@@ -3163,6 +3648,7 @@ dict_merge_dict(PyDictObject *a, PyDictObject *b, int override)
 
         // If other is clean, combined, and just allocated, just clone it.
         if (other->ma_values == NULL &&
+                dictkeys_oldkeys(okeys) == NULL &&
                 other->ma_used == okeys->dk_nentries &&
                 (DK_LOG_SIZE(okeys) == PyDict_LOG_MINSIZE ||
                     USABLE_FRACTION(DK_SIZE(okeys)/2) < other->ma_used)) {
@@ -3400,13 +3886,15 @@ PyDict_Copy(PyObject *o)
 
     if (Py_TYPE(mp)->tp_iter == (getiterfunc)dict_iter &&
             mp->ma_values == NULL &&
+            dictkeys_oldkeys(mp->ma_keys) == NULL &&
             (mp->ma_used >= (mp->ma_keys->dk_nentries * 2) / 3))
     {
         /* Use fast-copy if:
 
            (1) type(mp) doesn't override tp_iter; and
 
-           (2) 'mp' is not a split-dict; and
+           (2) 'mp' is not a split-dict, nor in the middle of an incremental
+               resize; and
 
            (3) if 'mp' is non-compact ('del' operation does not resize dicts),
                do fast-copy only if it has at most 1/3 non-used keys.
@@ -3503,7 +3991,11 @@ dict_equal(PyDictObject *a, PyDictObject *b)
     for (i = 0; i < a->ma_keys->dk_nentries; i++) {
         PyObject *key, *aval;
         Py_hash_t hash;
-        if (DK_IS_UNICODE(a->ma_keys)) {
+        PyDictKeysObject *oldkeys = a->ma_values ? NULL : dictkeys_oldkeys(a->ma_keys);
+        if (oldkeys != NULL) {
+            aval = dictkeys_get_entry(a->ma_keys, oldkeys, i, &key, &hash);
+        }
+        else if (DK_IS_UNICODE(a->ma_keys)) {
             PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(a->ma_keys)[i];
             key = ep->me_key;
             if (key == NULL) {
@@ -3648,6 +4140,9 @@ _PyDict_SetDefault_Hash(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObjec
     }
 
     if (!compatible_key(mp->ma_keys, key)) {
+        if (mp->ma_values != NULL) {
+            LAYOUT_STAT_INC(unshared_incompatible_key);
+        }
         if (insertion_resize(mp, 0) < 0) {
             return NULL;
         }
@@ -3669,13 +4164,14 @@ _PyDict_SetDefault_Hash(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObjec
             }
             return value;
         }
+        LAYOUT_STAT_INC(unshared_keys_full);
         if (insertion_resize(mp, 1) < 0) {
             return NULL;
         }
     }
 
     PyObject *value;
-    Py_ssize_t ix = _Py_dict_lookup(mp, key, hash, &value);
+    Py_ssize_t ix = dict_lookup_for_update(mp, key, hash, &value);
     if (ix == DKIX_ERROR)
         return NULL;
 
@@ -3692,7 +4188,8 @@ _PyDict_SetDefault_Hash(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObjec
             }
         }
         Py_ssize_t hashpos = find_empty_slot(mp->ma_keys, hash);
-        dictkeys_set_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries);
+        dictkeys_set_entry_index(mp->ma_keys, hashpos,
+                                 mp->ma_keys->dk_nentries, hash);
         if (DK_IS_UNICODE(mp->ma_keys)) {
             assert(PyUnicode_CheckExact(key));
             PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(mp->ma_keys)[mp->ma_keys->dk_nentries];
@@ -3747,6 +4244,21 @@ _PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj,
 }
 
 
+/* Same as dict.setdefault() but with hash supplied by caller.
+   Return a new reference. */
+PyObject *
+_PyDict_SetDefault_KnownHash(PyObject *d, PyObject *key, Py_hash_t hash,
+                             PyObject *defaultobj)
+{
+    assert(PyDict_Check(d));
+    PyObject *res;
+    Py_BEGIN_CRITICAL_SECTION(d);
+    res = _PyDict_SetDefault_Hash((PyDictObject *)d, key, hash, defaultobj,
+                                  1, NULL);
+    Py_END_CRITICAL_SECTION;
+    return res;
+}
+
 PyObject *
 PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
 {
@@ -3843,6 +4355,8 @@ dict_popitem_impl(PyDictObject *self)
             goto exit;
         }
     }
+    /* popitem() shrinks dk_nentries, which needs every entry in place */
+    dict_finish_resize(self);
     self->ma_keys->dk_version = 0;
 
     /* Pop last item */
@@ -3882,7 +4396,8 @@ dict_popitem_impl(PyDictObject *self)
 
     j = lookdict_index(self->ma_keys, hash, i);
     assert(j >= 0);
-    assert(dictkeys_get_index(self->ma_keys, j) == i);
+    assert(dictkeys_probe_index(self->ma_keys, j,
+                                dictkeys_hash_tag(self->ma_keys, hash)) == i);
     dictkeys_set_index(self->ma_keys, j, DKIX_DUMMY);
 
     PyTuple_SET_ITEM(res, 0, key);
@@ -3899,23 +4414,14 @@ dict_popitem_impl(PyDictObject *self)
 }
 
 static int
-dict_traverse(PyObject *op, visitproc visit, void *arg)
+dictkeys_traverse(PyDictKeysObject *keys, visitproc visit, void *arg)
 {
-    PyDictObject *mp = (PyDictObject *)op;
-    PyDictKeysObject *keys = mp->ma_keys;
     Py_ssize_t i, n = keys->dk_nentries;
 
     if (DK_IS_UNICODE(keys)) {
-        if (mp->ma_values != NULL) {
-            for (i = 0; i < n; i++) {
-                Py_VISIT(mp->ma_values->values[i]);
-            }
-        }
-        else {
-            PyDictUnicodeEntry *entries = DK_UNICODE_ENTRIES(keys);
-            for (i = 0; i < n; i++) {
-                Py_VISIT(entries[i].me_value);
-            }
+        PyDictUnicodeEntry *entries = DK_UNICODE_ENTRIES(keys);
+        for (i = 0; i < n; i++) {
+            Py_VISIT(entries[i].me_value);
         }
     }
     else {
@@ -3927,9 +4433,30 @@ dict_traverse(PyObject *op, visitproc visit, void *arg)
             }
         }
     }
+    /* Entries not moved yet by an incremental resize */
+    PyDictKeysObject *oldkeys = dictkeys_oldkeys(keys);
+    if (oldkeys != NULL) {
+        return dictkeys_traverse(oldkeys, visit, arg);
+    }
     return 0;
 }
 
+static int
+dict_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    PyDictObject *mp = (PyDictObject *)op;
+    PyDictKeysObject *keys = mp->ma_keys;
+    Py_ssize_t i, n = keys->dk_nentries;
+
+    if (mp->ma_values != NULL) {
+        for (i = 0; i < n; i++) {
+            Py_VISIT(mp->ma_values->values[i]);
+        }
+        return 0;
+    }
+    return dictkeys_traverse(keys, visit, arg);
+}
+
 static int
 dict_tp_clear(PyObject *op)
 {
@@ -3950,6 +4477,10 @@ _PyDict_SizeOf(PyDictObject *mp)
        in the type object. */
     if (mp->ma_keys->dk_kind != DICT_KEYS_SPLIT) {
         res += _PyDict_KeysSize(mp->ma_keys);
+        PyDictKeysObject *oldkeys = dictkeys_oldkeys(mp->ma_keys);
+        if (oldkeys != NULL) {
+            res += _PyDict_KeysSize(oldkeys);
+        }
     }
     assert(res <= (size_t)PY_SSIZE_T_MAX);
     return (Py_ssize_t)res;
@@ -3963,6 +4494,9 @@ _PyDict_KeysSize(PyDictKeysObject *keys)
     size_t size = sizeof(PyDictKeysObject);
     size += (size_t)1 << keys->dk_log2_index_bytes;
     size += USABLE_FRACTION((size_t)DK_SIZE(keys)) * es;
+    if (dictkeys_has_resize_state(keys)) {
+        size += sizeof(_PyDictResizeState);
+    }
     return size;
 }
 
@@ -4426,9 +4960,14 @@ dict_next_entry_with_lock(PyDictObject *d, PyDictKeysObject *k, Py_ssize_t i,
     if (!_PyObject_GC_IS_SHARED(d)) {
         _PyObject_GC_SET_SHARED(d);
     }
+    dict_resize_step(d, DICT_RESIZE_STEP);
+    PyDictKeysObject *oldkeys = dictkeys_oldkeys(k);
     while (i < k->dk_nentries) {
-        PyObject *key, *value;
-        if (DK_IS_UNICODE(k)) {
+        PyObject *key = NULL, *value;
+        if (oldkeys != NULL) {
+            value = dictkeys_get_entry(k, oldkeys, i, &key, NULL);
+        }
+        else if (DK_IS_UNICODE(k)) {
             PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(k)[i];
             key = ep->me_key;
             value = ep->me_value;
@@ -4492,6 +5031,9 @@ dict_next_entry(PyDictObject *d, PyDictKeysObject *k, Py_ssize_t i,
     Py_ssize_t n = _Py_atomic_load_ssize_relaxed(&k->dk_nentries);
     PyObject **keyptr, **valueptr;
     size_t step;
+    if (dictkeys_oldkeys(k) != NULL) {
+        return dict_next_entry_with_lock(d, k, i, out_key, out_value);
+    }
     if (DK_IS_UNICODE(k)) {
         keyptr = &DK_UNICODE_ENTRIES(k)[i].me_key;
         valueptr = &DK_UNICODE_ENTRIES(k)[i].me_value;
@@ -4804,7 +5346,15 @@ dictreviter_iternext(dictiterobject *di)
         assert (value != NULL);
     }
     else {
-        if (DK_IS_UNICODE(k)) {
+        PyDictKeysObject *oldkeys = dictkeys_oldkeys(k);
+        if (oldkeys != NULL) {
+            while ((value = dictkeys_get_entry(k, oldkeys, i, &key, NULL)) == NULL) {
+                if (--i < 0) {
+                    goto fail;
+                }
+            }
+        }
+        else if (DK_IS_UNICODE(k)) {
             PyDictUnicodeEntry *entry_ptr = &DK_UNICODE_ENTRIES(k)[i];
             while (entry_ptr->me_value == NULL) {
                 if (--i < 0) {
@@ -5742,6 +6292,97 @@ shared_keys_maybe_decrement_usable_size(PyDictKeysObject *keys)
     return (size_t)usable + (size_t)nentries;
 }
 
+/* Add to keys the names of the attributes that co assigns to its first
+   argument, as in "self.name = value".  Return -1 once keys are full. */
+static int
+shared_keys_add_self_attributes(PyDictKeysObject *keys, PyCodeObject *co)
+{
+    if (co->co_argcount == 0 ||
+        (_PyLocals_GetKind(co->co_localspluskinds, 0) & CO_FAST_CELL)) {
+        return 0;
+    }
+    _Py_CODEUNIT *instructions = _PyCode_CODE(co);
+    int loads_self = 0;
+    int oparg = 0;
+    for (Py_ssize_t i = 0; i < Py_SIZE(co); i++) {
+        int opcode = _PyOpcode_Deopt[_Py_OPCODE(instructions[i])];
+        oparg |= _Py_OPARG(instructions[i]);
+        if (opcode == EXTENDED_ARG) {
+            oparg <<= 8;
+            continue;
+        }
+        if (opcode == STORE_ATTR && loads_self) {
+            PyObject *name = PyTuple_GET_ITEM(co->co_names, oparg);
+            if (PyUnicode_CheckExact(name) && PyUnicode_CHECK_INTERNED(name) &&
+                insert_into_dictkeys(keys, name) == DKIX_EMPTY) {
+                return -1;
+            }
+        }
+        loads_self = (opcode == LOAD_FAST && oparg == 0);
+        oparg = 0;
+        i += _PyOpcode_Caches[opcode];
+    }
+    return 0;
+}
+
+/* Before the first instance of tp is created, add the attribute names that
+   the methods of tp and of its bases assign to self to its shared keys.
+   Instances created before those attributes are first set, from other
+   threads in particular, would otherwise each take some of the room left in
+   the shared keys, and later attributes would no longer fit.
+
+   The code of the methods is collected first, since that allocates.  The
+   names are then added under the type lock, and the prepopulated flag is
+   only set once they all are, so that a thread seeing the flag set never
+   creates an instance against partly filled keys. */
+static void
+shared_keys_prepopulate(PyDictKeysObject *keys, PyTypeObject *tp)
+{
+    PyObject *codes = PyList_New(0);
+    PyObject *mro = Py_XNewRef(tp->tp_mro);
+    int ok = codes != NULL && mro != NULL;
+    for (Py_ssize_t i = 0; ok && i < PyTuple_GET_SIZE(mro); i++) {
+        PyTypeObject *base = (PyTypeObject *)PyTuple_GET_ITEM(mro, i);
+        if (!(base->tp_flags & Py_TPFLAGS_HEAPTYPE) || base->tp_dict == NULL) {
+            continue;
+        }
+        PyObject *methods = PyDict_Values(base->tp_dict);
+        if (methods == NULL) {
+            break;
+        }
+        for (Py_ssize_t j = 0; ok && j < PyList_GET_SIZE(methods); j++) {
+            PyObject *func = PyList_GET_ITEM(methods, j);
+            if (PyFunction_Check(func)) {
+                ok = PyList_Append(codes, PyFunction_GET_CODE(func)) == 0;
+            }
+        }
+        Py_DECREF(methods);
+    }
+    Py_XDECREF(mro);
+    /* Without the code of all the methods, add the names of those found */
+    PyErr_Clear();
+
+    Py_ssize_t added = 0;
+    _PyMutex_lock(&_PyRuntime.mutex);
+    if (!_Py_atomic_load_uint8(&DK_AS_SPLIT(keys)->prepopulated)) {
+        Py_ssize_t nentries = _Py_atomic_load_ssize(&keys->dk_nentries);
+        for (Py_ssize_t i = 0; codes != NULL && i < PyList_GET_SIZE(codes);
+             i++) {
+            PyCodeObject *co = (PyCodeObject *)PyList_GET_ITEM(codes, i);
+            if (shared_keys_add_self_attributes(keys, co) < 0) {
+                break;
+            }
+        }
+        added = _Py_atomic_load_ssize(&keys->dk_nentries) - nentries;
+        _Py_atomic_store_uint8(&DK_AS_SPLIT(keys)->prepopulated, 1);
+    }
+    _PyMutex_unlock(&_PyRuntime.mutex);
+    Py_XDECREF(codes);
+    if (added > 0) {
+        LAYOUT_STAT_ADD(prepopulated_keys, added);
+    }
+}
+
 static int
 init_inline_values(PyObject *obj, PyTypeObject *tp)
 {
@@ -5750,6 +6391,9 @@ init_inline_values(PyObject *obj, PyTypeObject *tp)
     assert(tp->tp_flags & Py_TPFLAGS_MANAGED_DICT);
     PyDictKeysObject *keys = CACHED_KEYS(tp);
     assert(keys != NULL);
+    if (!_Py_atomic_load_uint8(&DK_AS_SPLIT(keys)->prepopulated)) {
+        shared_keys_prepopulate(keys, tp);
+    }
     size_t size = shared_keys_maybe_decrement_usable_size(keys);
     PyDictValues *values = new_values(size);
     if (values == NULL) {
@@ -5794,6 +6438,7 @@ _PyObject_InitializeDict(PyObject *obj)
 static PyObject *
 make_dict_from_instance_attributes(PyDictKeysObject *keys, PyDictValues *values)
 {
+    LAYOUT_STAT_INC(materialized);
     Py_ssize_t used = 0;
     Py_ssize_t track = 0;
     size_t size = shared_keys_usable_size(keys);
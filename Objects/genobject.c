@@ -6,7 +6,7 @@
 #include "pycore_call.h"          // _PyObject_CallNoArgs()
 #include "pycore_ceval.h"         // _PyEval_EvalFrame()
 #include "pycore_frame.h"         // _PyInterpreterFrame
-#include "pycore_genobject.h"     // struct _Py_async_gen_state
+#include "pycore_genobject.h"     // struct _Py_gen_state
 #include "pycore_object.h"        // _PyObject_GC_UNTRACK()
 #include "pycore_pyerrors.h"      // _PyErr_ClearExcState()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
@@ -111,6 +111,114 @@ _PyGen_Finalize(PyObject *self)
     PyErr_Restore(error_type, error_value, error_traceback);
 }
 
+/*************
+ * freelists *
+ *************/
+
+#define STATE (((PyThreadStateImpl *)tstate)->gen)
+
+static PyGenObject *
+gen_alloc(PyTypeObject *type, int slots)
+{
+#if _PyGen_NFREELISTS > 0
+    Py_ssize_t index = slots > 0 ? (slots - 1) / _PyGen_FREELIST_SLOTS : 0;
+    if (index < _PyGen_NFREELISTS) {
+        PyThreadState *tstate = _PyThreadState_GET();
+#ifdef Py_DEBUG
+        // gen_alloc() must not be called after _PyGen_Fini()
+        assert(STATE.numfree[index] != -1);
+#endif
+        PyGenObject *gen = STATE.free_list[index];
+        if (gen != NULL) {
+            STATE.free_list[index] = (PyGenObject *)gen->gi_code;
+            STATE.numfree[index]--;
+            Py_SET_TYPE(gen, type);
+            _Py_NewReference((PyObject *)gen);
+            OBJECT_STAT_INC(from_freelist);
+            return gen;
+        }
+        /* Round up so that the object can be pooled when it dies. */
+        slots = (int)(index + 1) * _PyGen_FREELIST_SLOTS;
+    }
+#endif
+    return PyObject_GC_NewVar(PyGenObject, type, slots);
+}
+
+static int
+gen_freelist_push(PyGenObject *gen)
+{
+#if _PyGen_NFREELISTS > 0
+    Py_ssize_t size = Py_SIZE(gen);
+    Py_ssize_t index = size / _PyGen_FREELIST_SLOTS - 1;
+    if (size % _PyGen_FREELIST_SLOTS != 0 ||
+        index < 0 || index >= _PyGen_NFREELISTS)
+    {
+        return 0;
+    }
+    PyThreadState *tstate = _PyThreadState_GET();
+#ifdef Py_DEBUG
+    // gen_dealloc() must not be called after _PyGen_Fini()
+    assert(STATE.numfree[index] != -1);
+#endif
+    if (STATE.numfree[index] < _PyGen_MAXFREELIST) {
+        gen->gi_code = (PyCodeObject *)STATE.free_list[index];
+        STATE.free_list[index] = gen;
+        STATE.numfree[index]++;
+        OBJECT_STAT_INC(to_freelist);
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+static void
+gen_freelist_clear(PyThreadState *tstate, int fini)
+{
+#if _PyGen_NFREELISTS > 0
+    for (Py_ssize_t i = 0; i < _PyGen_NFREELISTS; i++) {
+        PyGenObject *gen = STATE.free_list[i];
+        STATE.free_list[i] = NULL;
+        STATE.numfree[i] = fini ? -1 : 0;
+        while (gen != NULL) {
+            PyGenObject *next = (PyGenObject *)gen->gi_code;
+            PyObject_GC_Del(gen);
+            gen = next;
+        }
+    }
+#endif
+}
+
+void
+_PyGen_ClearFreeList(PyThreadState *tstate)
+{
+    gen_freelist_clear(tstate, 0);
+}
+
+void
+_PyGen_Fini(PyThreadState *tstate)
+{
+    gen_freelist_clear(tstate, 1);
+}
+
+/* Print summary info about the state of the optimized allocator */
+void
+_PyGen_DebugMallocStats(FILE *out)
+{
+#if _PyGen_NFREELISTS > 0
+    PyThreadState *tstate = _PyThreadState_GET();
+    for (int i = 0; i < _PyGen_NFREELISTS; i++) {
+        int slots = (i + 1) * _PyGen_FREELIST_SLOTS;
+        char buf[128];
+        PyOS_snprintf(buf, sizeof(buf),
+                      "free %d-slot PyGenObject", slots);
+        _PyDebugAllocatorStats(out, buf, STATE.numfree[i],
+                               _PyObject_VAR_SIZE(&PyGen_Type, slots));
+    }
+#endif
+}
+
+#undef STATE
+
 static void
 gen_dealloc(PyGenObject *gen)
 {
@@ -146,7 +254,9 @@ gen_dealloc(PyGenObject *gen)
     Py_CLEAR(gen->gi_name);
     Py_CLEAR(gen->gi_qualname);
     _PyErr_ClearExcState(&gen->gi_exc_state);
-    PyObject_GC_Del(gen);
+    if (!gen_freelist_push(gen)) {
+        PyObject_GC_Del(gen);
+    }
 }
 
 static PySendResult
@@ -851,7 +961,7 @@ make_gen(PyTypeObject *type, PyFunctionObject *func)
 {
     PyCodeObject *code = (PyCodeObject *)func->func_code;
     int slots = _PyFrame_NumSlotsForCodeObject(code);
-    PyGenObject *gen = PyObject_GC_NewVar(PyGenObject, type, slots);
+    PyGenObject *gen = gen_alloc(type, slots);
     if (gen == NULL) {
         return NULL;
     }
@@ -5,6 +5,7 @@
 #include "pycore_critical_section.h"
 #include "pycore_interp.h"        // PyInterpreterState.list
 #include "pycore_list.h"          // struct _Py_list_state, _PyListIterObject
+#include "pycore_lock.h"          // _PyRawEvent
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
 #include "pycore_tuple.h"         // _PyTuple_FromArray()
 #include <stddef.h>
@@ -116,6 +117,13 @@ list_ensure_capacity_slow(PyListObject *self, Py_ssize_t base, Py_ssize_t extra)
     if (!_Py_ThreadLocal((PyObject *)self)) {
         _PyObject_GC_SET_SHARED(self);
     }
+    if (extra == 1 && _PyObject_GC_IS_SHARED(self)) {
+        /* Appending to a shared list: grow by half at a time rather than
+           by the usual eighth.  Every reallocation copies the items while
+           other threads wait for the lock, and the old array can only be
+           freed once no lock-free reader can still be using it. */
+        reqsize += reqsize >> 1;
+    }
 
     size_t capacity = list_good_size(reqsize);
     _PyListArray *arr = list_allocate_array(capacity);
@@ -298,6 +306,27 @@ valid_index(Py_ssize_t i, Py_ssize_t limit)
     return (size_t) i < (size_t) limit;
 }
 
+/* Lock-free reads
+
+   Once a list is shared between threads, reading an item (indexing and
+   iteration, through list_fetch_item()) does not take the list's lock.
+   Writers hold the lock and keep to these rules:
+
+   - ob_item is replaced, with a release store, only after the items have
+     been copied to the new array.  The old array is freed through QSBR, so
+     a reader that loaded ob_item can keep indexing it.
+   - New items are stored before ob_size is raised to cover them, and
+     ob_size is raised with a release store (PyList_SetSize()).  A reader
+     that loads ob_size and sees an index below it also sees the item there.
+   - Slots at or beyond ob_size may hold stale pointers.
+
+   A reader takes a new reference to the item only if its reference count
+   is not already zero, then checks that neither the slot nor ob_item has
+   changed.  If either has, or the slot is NULL, it reads under the lock
+   instead.  A list that only its owning thread has used yet is read under
+   the lock the first time another thread reads it, which marks it shared
+   (see list_needs_read_lock()). */
+
 Py_NO_INLINE static PyObject *
 list_item_locked(PyListObject *self, Py_ssize_t idx, PyObject *dead)
 {
@@ -331,7 +360,7 @@ list_fetch_item(PyListObject *self, Py_ssize_t idx)
     if (list_needs_read_lock(self)) {
         return list_item_locked(self, idx, NULL);
     }
-    Py_ssize_t size = _Py_atomic_load_ssize_relaxed(&((PyVarObject *)self)->ob_size);
+    Py_ssize_t size = _Py_atomic_load_ssize(&((PyVarObject *)self)->ob_size);
     if (!valid_index(idx, size)) {
         return NULL;
     }
@@ -436,8 +465,8 @@ PyList_SetItem(PyObject *op, Py_ssize_t i,
 static void
 PyList_SetSize(PyListObject *self, Py_ssize_t size)
 {
-    // TODO(sgross): release?
-    _Py_atomic_store_ssize_relaxed(&((PyVarObject *)self)->ob_size, size);
+    // Release: lock-free readers that see the new size see the new items
+    _Py_atomic_store_ssize_release(&((PyVarObject *)self)->ob_size, size);
 }
 
 #define PyList_SET_SIZE PyList_SetSize
@@ -1071,7 +1100,7 @@ list_inplace_repeat_locked(PyListObject *self, Py_ssize_t n)
     }
     Py_ssize_t output_size = input_size * n;
 
-    if (list_resize(self, output_size) < 0)
+    if (list_ensure_capacity(self, output_size, 0) < 0)
         return NULL;
 
     PyObject **items = self->ob_item;
@@ -1080,6 +1109,7 @@ list_inplace_repeat_locked(PyListObject *self, Py_ssize_t n)
     }
     _Py_memory_repeat((char *)items, sizeof(PyObject *)*output_size,
                       sizeof(PyObject *)*input_size);
+    PyList_SetSize(self, output_size);
 
     return Py_NewRef(self);
 }
@@ -1652,6 +1682,11 @@ struct s_MergeState {
      * of tuples. It may be set to safe_object_compare, but the idea is that hopefully
      * we can assume more, and use one of the special-case compares. */
     int (*tuple_elem_compare)(PyObject *, PyObject *, MergeState *);
+
+    /* Set for the tasks of a parallel sort, which run without an attached
+     * thread state.  The compare functions then skip their debug checks,
+     * which call back into PyObject_RichCompareBool(). */
+    int detached;
 };
 
 /* binarysort is the best method for sorting small arrays: it does
@@ -1988,6 +2023,7 @@ merge_init(MergeState *ms, Py_ssize_t list_size, int has_keyfunc,
     ms->min_gallop = MIN_GALLOP;
     ms->listlen = list_size;
     ms->basekeys = lo->keys;
+    ms->detached = 0;
 }
 
 /* Free all the temp memory owned by the MergeState.  This must be called
@@ -2572,7 +2608,7 @@ unsafe_latin_compare(PyObject *v, PyObject *w, MergeState *ms)
            res < 0 :
            PyUnicode_GET_LENGTH(v) < PyUnicode_GET_LENGTH(w));
 
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));;
+    assert(ms->detached || res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2600,7 +2636,7 @@ unsafe_long_compare(PyObject *v, PyObject *w, MergeState *ms)
         w0 = -w0;
 
     res = v0 < w0;
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));
+    assert(ms->detached || res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2615,7 +2651,7 @@ unsafe_float_compare(PyObject *v, PyObject *w, MergeState *ms)
     assert(Py_IS_TYPE(w, &PyFloat_Type));
 
     res = PyFloat_AS_DOUBLE(v) < PyFloat_AS_DOUBLE(w);
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));
+    assert(ms->detached || res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2661,6 +2697,478 @@ unsafe_tuple_compare(PyObject *v, PyObject *w, MergeState *ms)
         return PyObject_RichCompareBool(vt->ob_item[i], wt->ob_item[i], Py_LT);
 }
 
+/* Sort the n elements of lo, using ms->key_compare, and leave them as the
+ * single run on ms's pending stack.  ms must have been set up by merge_init()
+ * for lo.  Returns 0 on success, -1 on error.
+ */
+static int
+merge_sort_slice(MergeState *ms, sortslice lo, Py_ssize_t nremaining)
+{
+    Py_ssize_t minrun;
+
+    /* March over the array once, left to right, finding natural runs,
+     * and extending short natural runs to minrun elements.
+     */
+    minrun = merge_compute_minrun(nremaining);
+    do {
+        int descending;
+        Py_ssize_t n;
+
+        /* Identify next run. */
+        n = count_run(ms, lo.keys, lo.keys + nremaining, &descending);
+        if (n < 0)
+            return -1;
+        if (descending)
+            reverse_sortslice(&lo, n);
+        /* If short, extend to min(minrun, nremaining). */
+        if (n < minrun) {
+            const Py_ssize_t force = nremaining <= minrun ?
+                              nremaining : minrun;
+            if (binarysort(ms, lo, lo.keys + force, lo.keys + n) < 0)
+                return -1;
+            n = force;
+        }
+        /* Maybe merge pending runs. */
+        assert(ms->n == 0 || ms->pending[ms->n -1].base.keys +
+                             ms->pending[ms->n-1].len == lo.keys);
+        if (found_new_run(ms, n) < 0)
+            return -1;
+        /* Push new run on stack. */
+        assert(ms->n < MAX_MERGE_PENDING);
+        ms->pending[ms->n].base = lo;
+        ms->pending[ms->n].len = n;
+        ++ms->n;
+        /* Advance to find next run. */
+        sortslice_advance(&lo, n);
+        nremaining -= n;
+    } while (nremaining);
+
+    return merge_force_collapse(ms);
+}
+
+/* Radix sort.
+ *
+ * When every key is an exact int of at most RADIX_INT_DIGITS digits (which
+ * fits in 64 bits) or an exact float, comparing keys is comparing 64-bit
+ * unsigned integers made from them, and a stable LSD radix sort on those
+ * replaces the comparison sort.  Passes over a digit that is the same in
+ * every key are skipped, so a list of small ints takes few passes.
+ *
+ * An int maps to its two's complement value with the sign bit flipped.  A
+ * float maps to its bits with the sign bit flipped if positive, and with
+ * all bits flipped if negative; -0.0 maps like 0.0, as they compare equal.
+ * NaNs have no place in that order, so a list with a NaN is left to the
+ * comparison sort, which gives the result users already get.
+ */
+
+#define RADIX_SORT_MIN 512
+#define RADIX_INT_DIGITS (63 / PyLong_SHIFT)
+/* Lists of at least RADIX_WIDE_MIN items are sorted 11 bits per pass
+   rather than 8: fewer passes, for larger tables of counts. */
+#define RADIX_WIDE_MIN (1 << 16)
+
+/* Return the radix key of v, which is not a NaN. */
+static inline uint64_t
+radix_key(PyObject *v, PyTypeObject *type)
+{
+    if (type == &PyLong_Type) {
+        PyLongObject *l = (PyLongObject *)v;
+        Py_ssize_t size = Py_SIZE(l);
+        uint64_t x = 0;
+        for (Py_ssize_t i = Py_ABS(size); --i >= 0; ) {
+            x = (x << PyLong_SHIFT) | l->ob_digit[i];
+        }
+        if (size < 0) {
+            x = (uint64_t)0 - x;
+        }
+        return x ^ ((uint64_t)1 << 63);
+    }
+    assert(type == &PyFloat_Type);
+    double d = PyFloat_AS_DOUBLE(v);
+    assert(!Py_IS_NAN(d));
+    if (d == 0.0) {
+        d = 0.0;
+    }
+    uint64_t x;
+    memcpy(&x, &d, sizeof(x));
+    return (x >> 63) ? ~x : x ^ ((uint64_t)1 << 63);
+}
+
+/* Sort the n keys of lo, all of the given type, and their values.
+ * Return 0 if sorted, or -1, leaving lo untouched, if a key has no radix
+ * key or the memory for the sort can't be gotten.  Sets no exception.
+ *
+ * Each pass moves the keys and values between lo and a scratch buffer of
+ * the same size, which is all the memory the sort needs besides the byte
+ * counts: the radix keys are recomputed from the objects on every pass
+ * rather than stored.
+ */
+static int
+radix_sort(sortslice lo, Py_ssize_t n, PyTypeObject *type)
+{
+    int has_values = lo.values != NULL;
+    int bits = n >= RADIX_WIDE_MIN ? 11 : 8;
+    int passes = (64 + bits - 1) / bits;
+    Py_ssize_t buckets = (Py_ssize_t)1 << bits;
+    uint64_t mask = (uint64_t)buckets - 1;
+
+    if ((size_t)n > PY_SSIZE_T_MAX / (2 * sizeof(PyObject *))) {
+        return -1;
+    }
+    if (type == &PyFloat_Type) {
+        for (Py_ssize_t i = 0; i < n; i++) {
+            if (Py_IS_NAN(PyFloat_AS_DOUBLE(lo.keys[i]))) {
+                return -1;
+            }
+        }
+    }
+    PyObject **scratch = PyMem_Malloc((has_values ? 2 : 1) * n *
+                                      sizeof(PyObject *));
+    if (scratch == NULL) {
+        return -1;
+    }
+    Py_ssize_t *counts = PyMem_Calloc(passes * buckets, sizeof(Py_ssize_t));
+    if (counts == NULL) {
+        PyMem_Free(scratch);
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        uint64_t key = radix_key(lo.keys[i], type);
+        for (int b = 0; b < passes; b++) {
+            counts[b * buckets + ((key >> (bits * b)) & mask)]++;
+        }
+    }
+
+    sortslice src = lo;
+    sortslice dst = {scratch, has_values ? scratch + n : NULL};
+    uint64_t first = radix_key(lo.keys[0], type);
+    for (int b = 0; b < passes; b++) {
+        int shift = bits * b;
+        Py_ssize_t *count = counts + b * buckets;
+        if (count[(first >> shift) & mask] == n) {
+            continue;       /* every key has the same digit here */
+        }
+        Py_ssize_t offset = 0;
+        for (Py_ssize_t d = 0; d < buckets; d++) {
+            Py_ssize_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (Py_ssize_t i = 0; i < n; i++) {
+            PyObject *k = src.keys[i];
+            Py_ssize_t j = count[(radix_key(k, type) >> shift) & mask]++;
+            dst.keys[j] = k;
+            if (has_values) {
+                dst.values[j] = src.values[i];
+            }
+        }
+        sortslice tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    /* Every pass leaves a whole permutation of the keys in lo.keys, which
+       is all that is needed of them when there are values. */
+    if (has_values) {
+        if (src.values != lo.values) {
+            memcpy(lo.values, src.values, n * sizeof(PyObject *));
+        }
+    }
+    else if (src.keys != lo.keys) {
+        memcpy(lo.keys, src.keys, n * sizeof(PyObject *));
+    }
+    PyMem_Free(counts);
+    PyMem_Free(scratch);
+    return 0;
+}
+
+/* Parallel sort.
+ *
+ * When every key is a latin-1 str, the compare function runs no Python
+ * code, cannot fail and touches no reference counts.  The same holds for
+ * word-sized ints and floats, but radix_sort() sorts those faster on its own,
+ * so they are left to it.  sort(parallel=True) splits the
+ * keys into chunks of at least PARALLEL_SORT_MIN_CHUNK elements, sorts each
+ * chunk on its own thread with the usual merge_sort_slice(), and merges
+ * adjacent chunks pairwise, in parallel, until one run remains.  Merging
+ * only adjacent runs, the lower one first, keeps the sort stable.
+ *
+ * The temp memory for every task is carved out of one block allocated up
+ * front, so the tasks never allocate.  A task whose range starts at index
+ * i uses the block from i/2 on, which needs every range to start at an even
+ * index.
+ *
+ * Since the tasks only read the keys, they run without a thread state: the
+ * calling thread detaches for the whole sort, and the workers of sort_pool
+ * never attach, so they never hold up a stop-the-world pause.  Their
+ * MergeState has detached set, so that the debug checks of the compare
+ * functions, which call PyObject_RichCompareBool(), are skipped.  The
+ * workers are started on first use and kept for later sorts.  If no worker
+ * is available, the calling thread runs the task itself.
+ */
+
+#define PARALLEL_SORT_MIN_CHUNK (1 << 14)
+#define PARALLEL_SORT_MAX_THREADS 64
+
+typedef struct {
+    MergeState ms;
+    sortslice lo;
+    Py_ssize_t na;          /* length of the first run to merge */
+    Py_ssize_t nb;          /* length of the second run, or 0 to sort lo */
+    int queued;             /* run by a worker of sort_pool */
+    _PyRawEvent done;       /* notified when the worker is done with it */
+} sort_task;
+
+typedef struct sort_worker {
+    _PyRawEvent wakeup;         /* notified when task is set */
+    sort_task *task;
+    struct sort_worker *next;   /* next idle worker */
+} sort_worker;
+
+static struct {
+    _PyRawMutex mutex;
+    sort_worker *idle;
+    Py_ssize_t nworkers;
+} sort_pool;
+
+/* Threads to use for a parallel sort, or 0 for one per online CPU */
+static Py_ssize_t parallel_sort_threads = 0;
+
+Py_ssize_t
+_PyList_SetParallelSortThreads(Py_ssize_t n)
+{
+    Py_ssize_t old = _Py_atomic_load_ssize_relaxed(&parallel_sort_threads);
+    _Py_atomic_store_ssize_relaxed(&parallel_sort_threads, n);
+    return old;
+}
+
+static int
+parallel_sort_possible(MergeState *ms, Py_ssize_t n)
+{
+    return (ms->key_compare == unsafe_latin_compare &&
+            n >= 2 * PARALLEL_SORT_MIN_CHUNK);
+}
+
+static Py_ssize_t
+parallel_sort_nthreads(Py_ssize_t n)
+{
+    Py_ssize_t nthreads = Py_MIN(n / PARALLEL_SORT_MIN_CHUNK,
+                                 PARALLEL_SORT_MAX_THREADS);
+    Py_ssize_t forced = _Py_atomic_load_ssize_relaxed(&parallel_sort_threads);
+    if (forced > 0) {
+        return Py_MIN(nthreads, forced);
+    }
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu >= 1 && ncpu < nthreads) {
+        nthreads = ncpu;
+    }
+#endif
+    return nthreads;
+}
+
+static void
+sort_task_run(sort_task *task)
+{
+    MergeState *ms = &task->ms;
+    int res;
+    if (task->nb == 0) {
+        res = merge_sort_slice(ms, task->lo, task->na);
+    }
+    else {
+        sortslice ssb = task->lo;
+        sortslice_advance(&ssb, task->na);
+        ms->pending[0].base = task->lo;
+        ms->pending[0].len = task->na;
+        ms->pending[1].base = ssb;
+        ms->pending[1].len = task->nb;
+        ms->n = 2;
+        res = (int)merge_at(ms, 0);
+    }
+    /* The compare functions cannot fail and the temp memory is big enough */
+    assert(res == 0);
+    (void)res;
+}
+
+static void
+sort_worker_main(void *arg)
+{
+    sort_worker *worker = (sort_worker *)arg;
+    for (;;) {
+        _PyRawEvent_Wait(&worker->wakeup);
+        _PyRawEvent_Reset(&worker->wakeup);
+        sort_task *task = worker->task;
+        sort_task_run(task);
+        _PyRawMutex_lock(&sort_pool.mutex);
+        worker->next = sort_pool.idle;
+        sort_pool.idle = worker;
+        _PyRawMutex_unlock(&sort_pool.mutex);
+        /* task must not be used after this */
+        _PyRawEvent_Notify(&task->done);
+    }
+}
+
+/* Hand task to an idle worker, starting a new one if there is none.
+   Returns 0 if no worker can take it. */
+static int
+sort_pool_submit(sort_task *task)
+{
+    _PyRawMutex_lock(&sort_pool.mutex);
+    sort_worker *worker = sort_pool.idle;
+    if (worker != NULL) {
+        sort_pool.idle = worker->next;
+    }
+    else if (sort_pool.nworkers < PARALLEL_SORT_MAX_THREADS - 1) {
+        sort_pool.nworkers++;
+    }
+    else {
+        _PyRawMutex_unlock(&sort_pool.mutex);
+        return 0;
+    }
+    _PyRawMutex_unlock(&sort_pool.mutex);
+
+    if (worker == NULL) {
+        worker = (sort_worker *)PyMem_RawCalloc(1, sizeof(sort_worker));
+        if (worker == NULL ||
+            PyThread_start_new_thread(sort_worker_main, worker) ==
+                PYTHREAD_INVALID_THREAD_ID) {
+            PyMem_RawFree(worker);
+            _PyRawMutex_lock(&sort_pool.mutex);
+            sort_pool.nworkers--;
+            _PyRawMutex_unlock(&sort_pool.mutex);
+            return 0;
+        }
+    }
+    worker->task = task;
+    _PyRawEvent_Notify(&worker->wakeup);
+    return 1;
+}
+
+void
+_PyList_AfterFork(void)
+{
+    /* The workers did not survive the fork */
+    sort_worker *worker = sort_pool.idle;
+    while (worker != NULL) {
+        sort_worker *next = worker->next;
+        PyMem_RawFree(worker);
+        worker = next;
+    }
+    memset(&sort_pool, 0, sizeof(sort_pool));
+}
+
+/* Run the tasks, all but the first on workers if possible, and wait for
+   them.  The calling thread must be detached. */
+static void
+sort_tasks_run(sort_task *tasks, Py_ssize_t ntasks)
+{
+    for (Py_ssize_t i = 1; i < ntasks; i++) {
+        _PyRawEvent_Reset(&tasks[i].done);
+        tasks[i].queued = sort_pool_submit(&tasks[i]);
+    }
+    for (Py_ssize_t i = 1; i < ntasks; i++) {
+        if (!tasks[i].queued) {
+            sort_task_run(&tasks[i]);
+        }
+    }
+    sort_task_run(&tasks[0]);
+    for (Py_ssize_t i = 1; i < ntasks; i++) {
+        if (tasks[i].queued) {
+            _PyRawEvent_Wait(&tasks[i].done);
+        }
+    }
+}
+
+/* Set up task to sort (nb == 0) or merge the elements of lo from index
+   start on, using the temp memory at scratch. */
+static void
+sort_task_init(sort_task *task, MergeState *ms, sortslice lo,
+               Py_ssize_t start, Py_ssize_t na, Py_ssize_t nb,
+               sortslice scratch)
+{
+    assert(start % 2 == 0);
+    sortslice_advance(&lo, start);
+    sortslice_advance(&scratch, start / 2);
+    task->lo = lo;
+    task->na = na;
+    task->nb = nb;
+    merge_init(&task->ms, na + nb, lo.values != NULL, &lo);
+    task->ms.key_compare = ms->key_compare;
+    task->ms.detached = 1;
+    task->ms.a = scratch;
+    task->ms.alloced = (na + nb + 1) / 2;
+}
+
+/* Sort the n elements of lo with parallel_sort_nthreads(n) threads.
+ * Returns 0 on success, -1 if the memory for it can't be gotten.
+ */
+static int
+parallel_sort(MergeState *ms, sortslice lo, Py_ssize_t n)
+{
+    Py_ssize_t nthreads = parallel_sort_nthreads(n);
+    if (nthreads < 2) {
+        if (merge_sort_slice(ms, lo, n) < 0)
+            return -1;
+        return 0;
+    }
+
+    int multiplier = lo.values != NULL ? 2 : 1;
+    Py_ssize_t half = (n + 1) / 2;
+    sort_task *tasks = PyMem_New(sort_task, nthreads);
+    Py_ssize_t *starts = PyMem_New(Py_ssize_t, nthreads + 1);
+    PyObject **mem = PyMem_New(PyObject *, multiplier * half);
+    if (tasks == NULL || starts == NULL || mem == NULL) {
+        PyMem_Free(tasks);
+        PyMem_Free(starts);
+        PyMem_Free(mem);
+        PyErr_NoMemory();
+        return -1;
+    }
+    sortslice scratch;
+    scratch.keys = mem;
+    scratch.values = lo.values != NULL ? &mem[half] : NULL;
+
+    /* Split into chunks of even length, but for the last one */
+    Py_ssize_t chunk = (n / nthreads) & ~(Py_ssize_t)1;
+    for (Py_ssize_t i = 0; i < nthreads; i++) {
+        starts[i] = i * chunk;
+    }
+    starts[nthreads] = n;
+
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t i = 0; i < nthreads; i++) {
+        sort_task_init(&tasks[i], ms, lo, starts[i],
+                       starts[i + 1] - starts[i], 0, scratch);
+    }
+    sort_tasks_run(tasks, nthreads);
+
+    /* Merge runs 2*i and 2*i+1 until one remains */
+    Py_ssize_t nruns = nthreads;
+    while (nruns > 1) {
+        Py_ssize_t ntasks = nruns / 2;
+        for (Py_ssize_t i = 0; i < ntasks; i++) {
+            Py_ssize_t start = starts[2 * i];
+            sort_task_init(&tasks[i], ms, lo, start,
+                           starts[2 * i + 1] - start,
+                           starts[2 * i + 2] - starts[2 * i + 1], scratch);
+        }
+        sort_tasks_run(tasks, ntasks);
+        for (Py_ssize_t i = 0; i <= nruns; i += 2) {
+            starts[i / 2] = starts[i];
+        }
+        if (nruns % 2) {
+            starts[ntasks + 1] = n;
+        }
+        nruns -= ntasks;
+    }
+    Py_END_ALLOW_THREADS
+
+    PyMem_Free(tasks);
+    PyMem_Free(starts);
+    PyMem_Free(mem);
+    return 0;
+}
+
 /* An adaptive, stable, natural mergesort.  See listsort.txt.
  * Returns Py_None on success, NULL on error.  Even in case of error, the
  * list will be some permutation of its input state (nothing is lost or
@@ -2672,6 +3180,7 @@ list.sort
     *
     key as keyfunc: object = None
     reverse: bool = False
+    parallel: bool = False
 
 Sort the list in ascending order and return None.
 
@@ -2682,15 +3191,18 @@ If a key function is given, apply it once to each list item and sort them,
 ascending or descending, according to their function values.
 
 The reverse flag can be set to sort in descending order.
+
+If parallel is true, a large list whose keys are all Latin-1 strings may
+be sorted by several threads.
 [clinic start generated code]*/
 
 static PyObject *
-list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
-/*[clinic end generated code: output=57b9f9c5e23fbe42 input=a74c4cd3ec6b5c08]*/
+list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse,
+               int parallel)
+/*[clinic end generated code: output=9d46a93c53c0d19d input=d46ac9beba811edb]*/
 {
     MergeState ms;
     Py_ssize_t nremaining;
-    Py_ssize_t minrun;
     sortslice lo;
     Py_ssize_t saved_ob_size, saved_allocated;
     PyObject **saved_ob_item;
@@ -2698,6 +3210,7 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
     PyObject *result = NULL;            /* guilty until proved innocent */
     Py_ssize_t i;
     PyObject **keys;
+    PyTypeObject *radix_type = NULL;    /* set if radix_sort() applies */
 
     assert(self != NULL);
     assert(PyList_Check(self));
@@ -2765,6 +3278,7 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
         int keys_are_all_same_type = 1;
         int strings_are_latin = 1;
         int ints_are_bounded = 1;
+        int ints_fit_word = 1;
 
         /* Prove that assumption by checking every key. */
         for (i=0; i < saved_ob_size; i++) {
@@ -2794,10 +3308,11 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
 
             if (keys_are_all_same_type) {
                 if (key_type == &PyLong_Type &&
-                    ints_are_bounded &&
+                    ints_fit_word &&
                     Py_ABS(Py_SIZE(key)) > 1) {
 
                     ints_are_bounded = 0;
+                    ints_fit_word = Py_ABS(Py_SIZE(key)) <= RADIX_INT_DIGITS;
                 }
                 else if (key_type == &PyUnicode_Type &&
                          strings_are_latin &&
@@ -2809,6 +3324,11 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
             }
 
         /* Choose the best compare, given what we now know about the keys. */
+        if (keys_are_all_same_type && !keys_are_in_tuples &&
+            ((key_type == &PyLong_Type && ints_fit_word) ||
+             key_type == &PyFloat_Type)) {
+            radix_type = key_type;
+        }
         if (keys_are_all_same_type) {
 
             if (key_type == &PyUnicode_Type && strings_are_latin) {
@@ -2860,44 +3380,18 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
         reverse_slice(&saved_ob_item[0], &saved_ob_item[saved_ob_size]);
     }
 
-    /* March over the array once, left to right, finding natural runs,
-     * and extending short natural runs to minrun elements.
-     */
-    minrun = merge_compute_minrun(nremaining);
-    do {
-        int descending;
-        Py_ssize_t n;
+    if (radix_type != NULL && saved_ob_size >= RADIX_SORT_MIN &&
+        radix_sort(lo, saved_ob_size, radix_type) == 0) {
+        goto succeed;
+    }
 
-        /* Identify next run. */
-        n = count_run(&ms, lo.keys, lo.keys + nremaining, &descending);
-        if (n < 0)
-            goto fail;
-        if (descending)
-            reverse_sortslice(&lo, n);
-        /* If short, extend to min(minrun, nremaining). */
-        if (n < minrun) {
-            const Py_ssize_t force = nremaining <= minrun ?
-                              nremaining : minrun;
-            if (binarysort(&ms, lo, lo.keys + force, lo.keys + n) < 0)
-                goto fail;
-            n = force;
-        }
-        /* Maybe merge pending runs. */
-        assert(ms.n == 0 || ms.pending[ms.n -1].base.keys +
-                            ms.pending[ms.n-1].len == lo.keys);
-        if (found_new_run(&ms, n) < 0)
+    if (parallel && parallel_sort_possible(&ms, saved_ob_size)) {
+        if (parallel_sort(&ms, lo, saved_ob_size) < 0)
             goto fail;
-        /* Push new run on stack. */
-        assert(ms.n < MAX_MERGE_PENDING);
-        ms.pending[ms.n].base = lo;
-        ms.pending[ms.n].len = n;
-        ++ms.n;
-        /* Advance to find next run. */
-        sortslice_advance(&lo, n);
-        nremaining -= n;
-    } while (nremaining);
+        goto succeed;
+    }
 
-    if (merge_force_collapse(&ms) < 0)
+    if (merge_sort_slice(&ms, lo, nremaining) < 0)
         goto fail;
     assert(ms.n == 1);
     assert(keys == NULL
@@ -2955,7 +3449,7 @@ PyList_Sort(PyObject *v)
         PyErr_BadInternalCall();
         return -1;
     }
-    v = list_sort_impl((PyListObject *)v, NULL, 0);
+    v = list_sort_impl((PyListObject *)v, NULL, 0, 0);
     if (v == NULL)
         return -1;
     Py_DECREF(v);
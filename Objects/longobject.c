@@ -39,9 +39,6 @@ medium_value(PyLongObject *x)
 #define _MAX_STR_DIGITS_ERROR_FMT_TO_INT "Exceeds the limit (%d digits) for integer string conversion: value has %zd digits; use sys.set_int_max_str_digits() to increase the limit"
 #define _MAX_STR_DIGITS_ERROR_FMT_TO_STR "Exceeds the limit (%d digits) for integer string conversion; use sys.set_int_max_str_digits() to increase the limit"
 
-/* If defined, use algorithms from the _pylong.py module */
-#define WITH_PYLONG_MODULE 1
-
 static inline void
 _Py_DECREF_INT(PyLongObject *op)
 {
@@ -86,6 +83,14 @@ maybe_small_long(PyLongObject *v)
 #define KARATSUBA_CUTOFF 70
 #define KARATSUBA_SQUARE_CUTOFF (2 * KARATSUBA_CUTOFF)
 
+/* Above Karatsuba, k_mul() switches to Toom-3 when the smaller operand has
+ * at least TOOM3_CUTOFF digits (TOOM3_SQUARE_CUTOFF for squares), and to
+ * number-theoretic transforms when it has at least NTT_CUTOFF digits.
+ */
+#define TOOM3_CUTOFF 250
+#define TOOM3_SQUARE_CUTOFF (3 * TOOM3_CUTOFF)
+#define NTT_CUTOFF 3000
+
 /* For exponentiation, use the binary left-to-right algorithm unless the
  ^ exponent contains more than HUGE_EXP_CUTOFF bits.  In that case, do
  * (no more than) EXP_WINDOW_SIZE bits at a time.  The potential drawback is
@@ -1735,71 +1740,656 @@ rem1(PyLongObject *a, digit n)
     );
 }
 
-#ifdef WITH_PYLONG_MODULE
-/* asymptotically faster long_to_decimal_string, using _pylong.py */
+/* Number-theoretic transform multiplication.
+
+   Huge operands are multiplied by convolving their digit sequences with
+   number-theoretic transforms modulo three primes p, 2**30 < p < 2**31, and
+   reconstructing each coefficient of the convolution with the Chinese
+   remainder theorem.  A coefficient is the sum of at most 2**24 products of
+   two digits below 2**30, so it is below 2**84, well within the product of
+   the primes (about 2**92.6).  The same code multiplies base PyLong_BASE
+   digits for k_mul() and base _PyLong_DECIMAL_BASE digits for dec_mul().
+
+   The transforms use Montgomery multiplication with R = 2**32.  The forward
+   transform is a decimation in frequency that leaves its output in
+   bit-reversed order, and the inverse transform a decimation in time that
+   takes its input in that order, so no reordering pass is needed. */
+
+/* The convolutions have at most 2**NTT_MAX_LOG coefficients, the largest
+   power of two dividing p - 1 for all three primes. */
+#define NTT_MAX_LOG 25
+
+typedef struct {
+    uint32_t p;
+    uint32_t pinv;      /* -1/p modulo 2**32 */
+} ntt_prime;
+
+static inline uint32_t
+ntt_mulmod(uint32_t a, uint32_t b, const ntt_prime *m)
+{
+    /* Montgomery reduction of a*b: returns a*b/R modulo p, for a, b < p. */
+    uint64_t t = (uint64_t)a * b;
+    uint32_t q = (uint32_t)t * m->pinv;
+    uint32_t u = (uint32_t)((t + (uint64_t)q * m->p) >> 32);
+    return u >= m->p ? u - m->p : u;
+}
+
+static inline uint32_t
+ntt_addmod(uint32_t a, uint32_t b, uint32_t p)
+{
+    uint32_t s = a + b;
+    return s >= p ? s - p : s;
+}
+
+static inline uint32_t
+ntt_submod(uint32_t a, uint32_t b, uint32_t p)
+{
+    return a >= b ? a - b : a + p - b;
+}
+
+/* x**e modulo p, without Montgomery representation. */
+static uint32_t
+ntt_powmod(uint32_t x, uint64_t e, uint32_t p)
+{
+    uint64_t result = 1, base = x % p;
+    while (e) {
+        if (e & 1) {
+            result = result * base % p;
+        }
+        base = base * base % p;
+        e >>= 1;
+    }
+    return (uint32_t)result;
+}
+
+/* Store the Montgomery representations of w**j in roots[j], for j < half. */
+static void
+ntt_roots(uint32_t *roots, Py_ssize_t half, uint32_t w, const ntt_prime *m)
+{
+    uint32_t wm = (uint32_t)(((uint64_t)w << 32) % m->p);
+    roots[0] = (uint32_t)(((uint64_t)1 << 32) % m->p);
+    for (Py_ssize_t j = 1; j < half; j++) {
+        roots[j] = ntt_mulmod(roots[j - 1], wm, m);
+    }
+}
+
+static void
+ntt_forward(uint32_t *a, Py_ssize_t n, const uint32_t *roots,
+            const ntt_prime *m)
+{
+    uint32_t p = m->p;
+    for (Py_ssize_t len = n >> 1, step = 1; len >= 1; len >>= 1, step <<= 1) {
+        for (Py_ssize_t i = 0; i < n; i += 2 * len) {
+            uint32_t *x = a + i, *y = a + i + len;
+            for (Py_ssize_t j = 0; j < len; j++) {
+                uint32_t u = x[j], v = y[j];
+                x[j] = ntt_addmod(u, v, p);
+                y[j] = ntt_mulmod(ntt_submod(u, v, p), roots[j * step], m);
+            }
+        }
+    }
+}
+
+static void
+ntt_inverse(uint32_t *a, Py_ssize_t n, const uint32_t *iroots,
+            const ntt_prime *m)
+{
+    uint32_t p = m->p;
+    for (Py_ssize_t len = 1, step = n >> 1; len < n; len <<= 1, step >>= 1) {
+        for (Py_ssize_t i = 0; i < n; i += 2 * len) {
+            uint32_t *x = a + i, *y = a + i + len;
+            for (Py_ssize_t j = 0; j < len; j++) {
+                uint32_t u = x[j], v = ntt_mulmod(y[j], iroots[j * step], m);
+                x[j] = ntt_addmod(u, v, p);
+                y[j] = ntt_submod(u, v, p);
+            }
+        }
+    }
+}
+
+/* Store the na+nb digit product of a[0:na] and b[0:nb], in base `base`
+   (at most 2**30), in z.  na + nb must be at most 2**NTT_MAX_LOG, and z must
+   not overlap the inputs.  Returns -1 with MemoryError set on failure. */
 static int
-pylong_int_to_decimal_string(PyObject *aa,
-                             PyObject **p_output,
-                             _PyUnicodeWriter *writer,
-                             _PyBytesWriter *bytes_writer,
-                             char **bytes_str)
-{
-    PyObject *s = NULL;
-    PyObject *mod = PyImport_ImportModule("_pylong");
-    if (mod == NULL) {
+ntt_mul_digits(const digit *a, Py_ssize_t na, const digit *b, Py_ssize_t nb,
+               digit *z, twodigits base)
+{
+    /* The primes and a primitive root modulo each. */
+    static const uint32_t primes[3][2] = {
+        {2013265921, 31},       /* 15 * 2**27 + 1 */
+        {1811939329, 13},       /* 27 * 2**26 + 1 */
+        {2113929217, 5},        /* 63 * 2**25 + 1 */
+    };
+    Py_ssize_t n = 2, half, i, nc = na + nb - 1;
+    int square = a == b && na == nb;
+    uint32_t *res[3], *fb, *roots, *iroots, *buf;
+    uint64_t carry;
+
+    assert(na > 0 && nb > 0);
+    assert(na + nb <= ((Py_ssize_t)1 << NTT_MAX_LOG));
+    while (n < nc) {
+        n <<= 1;
+    }
+    half = n >> 1;
+    buf = PyMem_New(uint32_t, 5 * n);
+    if (buf == NULL) {
+        PyErr_NoMemory();
         return -1;
     }
-    s = PyObject_CallMethod(mod, "int_to_decimal_string", "O", aa);
-    if (s == NULL) {
-        goto error;
+    res[0] = buf;
+    res[1] = buf + n;
+    res[2] = buf + 2 * n;
+    fb = buf + 3 * n;
+    roots = buf + 4 * n;
+    iroots = roots + half;
+
+    for (int k = 0; k < 3; k++) {
+        ntt_prime m;
+        uint32_t p = primes[k][0], w, scale, *fa = res[k];
+        uint32_t inv = p;
+        uint64_t r;
+
+        /* Newton's iteration for 1/p modulo 2**32 doubles the number of
+           correct low bits, starting from 3. */
+        for (i = 0; i < 4; i++) {
+            inv *= 2 - p * inv;
+        }
+        m.p = p;
+        m.pinv = (uint32_t)0 - inv;
+
+        w = ntt_powmod(primes[k][1], (p - 1) / n, p);
+        ntt_roots(roots, half, w, &m);
+        ntt_roots(iroots, half, ntt_powmod(w, p - 2, p), &m);
+
+        for (i = 0; i < na; i++) {
+            fa[i] = a[i];
+        }
+        memset(fa + na, 0, (n - na) * sizeof(uint32_t));
+        ntt_forward(fa, n, roots, &m);
+        if (square) {
+            for (i = 0; i < n; i++) {
+                fa[i] = ntt_mulmod(fa[i], fa[i], &m);
+            }
+        }
+        else {
+            for (i = 0; i < nb; i++) {
+                fb[i] = b[i];
+            }
+            memset(fb + nb, 0, (n - nb) * sizeof(uint32_t));
+            ntt_forward(fb, n, roots, &m);
+            for (i = 0; i < n; i++) {
+                fa[i] = ntt_mulmod(fa[i], fb[i], &m);
+            }
+        }
+        ntt_inverse(fa, n, iroots, &m);
+
+        /* The pointwise products divided by R, and the inverse transform
+           multiplied by n: scale by R/n, that is, Montgomery-multiply by
+           R**2/n. */
+        r = ((uint64_t)1 << 32) % p;
+        scale = (uint32_t)((uint64_t)ntt_powmod((uint32_t)n, p - 2, p) *
+                           (r * r % p) % p);
+        for (i = 0; i < nc; i++) {
+            fa[i] = ntt_mulmod(fa[i], scale, &m);
+        }
     }
-    if (!PyUnicode_Check(s)) {
-        PyErr_SetString(PyExc_TypeError,
-                        "_pylong.int_to_decimal_string did not return a str");
-        goto error;
+
+    /* Garner's algorithm: a coefficient x with residues r0, r1, r2 is
+       r0 + p0*(c1 + p1*c2), where c1 = (r1 - r0)/p0 modulo p1 and
+       c2 = (r2 - r0 - p0*c1)/(p0*p1) modulo p2.  Then propagate carries
+       in base `base`. */
+    {
+        uint64_t p0 = primes[0][0], p1 = primes[1][0], p2 = primes[2][0];
+        uint64_t inv01 = ntt_powmod((uint32_t)(p0 % p1), p1 - 2,
+                                    (uint32_t)p1);
+        uint64_t inv012 = ntt_powmod((uint32_t)(p0 * p1 % p2), p2 - 2,
+                                     (uint32_t)p2);
+        carry = 0;
+        for (i = 0; i < nc; i++) {
+            uint64_t r0 = res[0][i], r1 = res[1][i], r2 = res[2][i];
+            uint64_t c1, c2, v, vh, t;
+
+            c1 = (r1 + p1 - r0 % p1) % p1 * inv01 % p1;
+            t = (r0 + p0 * c1) % p2;
+            c2 = (r2 + p2 - t) % p2 * inv012 % p2;
+            /* x = r0 + p0*v < 2**84, so v < 2**54. */
+            v = c1 + p1 * c2;
+            vh = v / base;
+            t = p0 * (v - vh * base) + r0 + carry;
+            carry = t / base;
+            z[i] = (digit)(t - carry * base);
+            carry += p0 * vh;
+        }
+        assert(carry < base);
+        z[nc] = (digit)carry;
     }
-    if (writer) {
-        Py_ssize_t size = PyUnicode_GET_LENGTH(s);
-        if (_PyUnicodeWriter_Prepare(writer, size, '9') == -1) {
-            goto error;
+    PyMem_Free(buf);
+    return 0;
+}
+
+/* Memo of the powers used by one of the subquadratic base conversions below.
+   Values are owned by the cache; once it is full, new powers are simply not
+   memoized. */
+#define POW_CACHE_SIZE 128
+
+typedef struct {
+    Py_ssize_t n;
+    Py_ssize_t exp[POW_CACHE_SIZE];
+    PyLongObject *value[POW_CACHE_SIZE];
+} pow_cache;
+
+/* Return a borrowed reference to the cached power for exp, or NULL. */
+static PyLongObject *
+pow_cache_get(pow_cache *cache, Py_ssize_t exp)
+{
+    for (Py_ssize_t i = 0; i < cache->n; i++) {
+        if (cache->exp[i] == exp) {
+            return cache->value[i];
         }
-        if (_PyUnicodeWriter_WriteStr(writer, s) < 0) {
-            goto error;
+    }
+    return NULL;
+}
+
+static void
+pow_cache_put(pow_cache *cache, Py_ssize_t exp, PyLongObject *value)
+{
+    if (cache->n < POW_CACHE_SIZE) {
+        cache->exp[cache->n] = exp;
+        cache->value[cache->n] = (PyLongObject *)Py_NewRef(value);
+        cache->n++;
+    }
+}
+
+static void
+pow_cache_clear(pow_cache *cache)
+{
+    for (Py_ssize_t i = 0; i < cache->n; i++) {
+        Py_DECREF(cache->value[i]);
+    }
+    cache->n = 0;
+}
+
+/* Convert the size_a base PyLong_BASE digits at pin to base
+   _PyLong_DECIMAL_BASE, using the simple quadratic algorithm.  The result
+   is a scratch object whose Py_SIZE() is the number of decimal digits (0
+   for zero, but there is always room for one digit), or NULL on error. */
+static PyLongObject *
+long_to_decimal_digits(const digit *pin, Py_ssize_t size_a)
+{
+    PyLongObject *scratch;
+    Py_ssize_t size, i, j;
+    digit *pout;
+    int d;
+
+    /* quick and dirty upper bound for the number of digits
+       required to express a in base _PyLong_DECIMAL_BASE:
+
+         #digits = 1 + floor(log2(a) / log2(_PyLong_DECIMAL_BASE))
+
+       But log2(a) < size_a * PyLong_SHIFT, and
+       log2(_PyLong_DECIMAL_BASE) = log2(10) * _PyLong_DECIMAL_SHIFT
+                                  > 3.3 * _PyLong_DECIMAL_SHIFT
+
+         size_a * PyLong_SHIFT / (3.3 * _PyLong_DECIMAL_SHIFT) =
+             size_a + size_a / d < size_a + size_a / floor(d),
+       where d = (3.3 * _PyLong_DECIMAL_SHIFT) /
+                 (PyLong_SHIFT - 3.3 * _PyLong_DECIMAL_SHIFT)
+    */
+    d = (33 * _PyLong_DECIMAL_SHIFT) /
+        (10 * PyLong_SHIFT - 33 * _PyLong_DECIMAL_SHIFT);
+    assert(size_a < PY_SSIZE_T_MAX/2);
+    size = 1 + size_a + size_a / d;
+    scratch = _PyLong_New(size);
+    if (scratch == NULL)
+        return NULL;
+
+    /* convert array of base _PyLong_BASE digits in pin to an array of
+       base _PyLong_DECIMAL_BASE digits in pout, following Knuth (TAOCP,
+       Volume 2 (3rd edn), section 4.4, Method 1b). */
+    pout = scratch->ob_digit;
+    size = 0;
+    for (i = size_a; --i >= 0; ) {
+        digit hi = pin[i];
+        for (j = 0; j < size; j++) {
+            twodigits z = (twodigits)pout[j] << PyLong_SHIFT | hi;
+            hi = (digit)(z / _PyLong_DECIMAL_BASE);
+            pout[j] = (digit)(z - (twodigits)hi *
+                              _PyLong_DECIMAL_BASE);
         }
-        goto success;
+        while (hi) {
+            pout[size++] = hi % _PyLong_DECIMAL_BASE;
+            hi /= _PyLong_DECIMAL_BASE;
+        }
+        /* check for keyboard interrupt */
+        SIGCHECK({
+                Py_DECREF(scratch);
+                return NULL;
+            });
     }
-    else if (bytes_writer) {
-        Py_ssize_t size = PyUnicode_GET_LENGTH(s);
-        const void *data = PyUnicode_DATA(s);
-        int kind = PyUnicode_KIND(s);
-        *bytes_str = _PyBytesWriter_Prepare(bytes_writer, *bytes_str, size);
-        if (*bytes_str == NULL) {
-            goto error;
+    Py_SET_SIZE(scratch, size);
+    return scratch;
+}
+
+/* Subquadratic conversion to decimal.
+
+   Large ints are split in two, a = hi * 2**(PyLong_SHIFT*k) + lo, both
+   halves are converted recursively and the result is recombined in base
+   _PyLong_DECIMAL_BASE.  That is the algorithm of _pylong.int_to_decimal(),
+   with the decimal arithmetic done directly on arrays of base
+   _PyLong_DECIMAL_BASE digits, multiplying them with Karatsuba.  Like the
+   simple algorithm, it keeps the decimal digits in the ob_digit array of
+   scratch PyLongObjects.
+
+   Ints with more than DEC_CONVERSION_CUTOFF digits use it, and it converts
+   pieces of up to DEC_CONVERSION_CUTOFF digits with the simple algorithm.
+   Decimal numbers shorter than DEC_KARATSUBA_CUTOFF digits are multiplied
+   with the schoolbook algorithm, and those of DEC_NTT_CUTOFF digits or more
+   with ntt_mul_digits(). */
+#define DEC_CONVERSION_CUTOFF 40
+#define DEC_KARATSUBA_CUTOFF 192
+#define DEC_NTT_CUTOFF 2000
+
+/* z[0:m] += a[0:n] in base _PyLong_DECIMAL_BASE, with m >= n.  Returns the
+   carry out of z[m-1]. */
+static digit
+dec_iadd(digit *z, Py_ssize_t m, const digit *a, Py_ssize_t n)
+{
+    digit carry = 0;
+    Py_ssize_t i;
+
+    assert(m >= n);
+    for (i = 0; i < n; i++) {
+        carry += z[i] + a[i];
+        if (carry >= _PyLong_DECIMAL_BASE) {
+            z[i] = carry - _PyLong_DECIMAL_BASE;
+            carry = 1;
         }
-        char *p = *bytes_str;
-        for (Py_ssize_t i=0; i < size; i++) {
-            Py_UCS4 ch = PyUnicode_READ(kind, data, i);
-            *p++ = (char) ch;
+        else {
+            z[i] = carry;
+            carry = 0;
         }
-        (*bytes_str) = p;
-        goto success;
     }
-    else {
-        *p_output = Py_NewRef(s);
-        goto success;
+    for (; carry && i < m; i++) {
+        if (++z[i] == _PyLong_DECIMAL_BASE) {
+            z[i] = 0;
+        }
+        else {
+            carry = 0;
+        }
     }
+    return carry;
+}
 
-error:
-        Py_DECREF(mod);
-        Py_XDECREF(s);
-        return -1;
+/* z[0:m] -= a[0:n] in base _PyLong_DECIMAL_BASE, with m >= n and z >= a. */
+static void
+dec_isub(digit *z, Py_ssize_t m, const digit *a, Py_ssize_t n)
+{
+    digit borrow = 0;
+    Py_ssize_t i;
 
-success:
-        Py_DECREF(mod);
-        Py_DECREF(s);
+    assert(m >= n);
+    for (i = 0; i < n; i++) {
+        digit d = a[i] + borrow;
+        if (z[i] >= d) {
+            z[i] -= d;
+            borrow = 0;
+        }
+        else {
+            z[i] = z[i] + _PyLong_DECIMAL_BASE - d;
+            borrow = 1;
+        }
+    }
+    for (; borrow && i < m; i++) {
+        if (z[i] == 0) {
+            z[i] = _PyLong_DECIMAL_BASE - 1;
+        }
+        else {
+            z[i]--;
+            borrow = 0;
+        }
+    }
+    assert(borrow == 0);
+}
+
+/* The schoolbook multiplication below adds up to DEC_MUL_ROWS rows of
+   products into twodigits accumulators before propagating the carries. */
+#define DEC_MUL_ROWS ((twodigits)-1 / \
+                      ((twodigits)_PyLong_DECIMAL_BASE * _PyLong_DECIMAL_BASE) - 1)
+
+/* Schoolbook part of dec_mul(), for na < DEC_KARATSUBA_CUTOFF. */
+static int
+dec_mul_simple(const digit *a, Py_ssize_t na, const digit *b, Py_ssize_t nb,
+               digit *z)
+{
+    twodigits stack_acc[2 * DEC_KARATSUBA_CUTOFF];
+    twodigits *acc = stack_acc;
+    Py_ssize_t i, j, k, nz = na + nb;
+
+    if (nz > (Py_ssize_t)Py_ARRAY_LENGTH(stack_acc)) {
+        acc = PyMem_New(twodigits, nz);
+        if (acc == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    memset(acc, 0, nz * sizeof(twodigits));
+    for (i = 0; i < na; i += DEC_MUL_ROWS) {
+        Py_ssize_t rows = Py_MIN(na - i, (Py_ssize_t)DEC_MUL_ROWS);
+        twodigits carry = 0;
+        for (k = i; k < i + rows; k++) {
+            twodigits f = a[k];
+            twodigits *pacc = acc + k;
+            for (j = 0; j < nb; j++) {
+                pacc[j] += f * b[j];
+            }
+        }
+        for (k = i; k < i + rows + nb; k++) {
+            twodigits t = acc[k] + carry;
+            carry = t / _PyLong_DECIMAL_BASE;
+            acc[k] = t - carry * _PyLong_DECIMAL_BASE;
+        }
+        assert(carry == 0);
+    }
+    for (k = 0; k < nz; k++) {
+        z[k] = (digit)acc[k];
+    }
+    if (acc != stack_acc) {
+        PyMem_Free(acc);
+    }
+    return 0;
+}
+
+/* Store the na+nb digit product of a[0:na] and b[0:nb] in z, all in base
+   _PyLong_DECIMAL_BASE.  z must not overlap the inputs.  Returns -1 with
+   MemoryError set on failure. */
+static int
+dec_mul(const digit *a, Py_ssize_t na, const digit *b, Py_ssize_t nb,
+        digit *z)
+{
+    Py_ssize_t i, s, nah, nbh, nt;
+    digit *buf, *sa, *sb, *t;
+
+    if (na > nb) {
+        const digit *tmp = a;
+        a = b;
+        b = tmp;
+        i = na;
+        na = nb;
+        nb = i;
+    }
+    if (na < DEC_KARATSUBA_CUTOFF) {
+        return dec_mul_simple(a, na, b, nb, z);
+    }
+    if (na >= DEC_NTT_CUTOFF && na + nb <= ((Py_ssize_t)1 << NTT_MAX_LOG)) {
+        return ntt_mul_digits(a, na, b, nb, z, _PyLong_DECIMAL_BASE);
+    }
+
+    s = (nb + 1) / 2;
+    if (na <= s) {
+        /* Lopsided: multiply a by slices of b that are as long as a. */
+        buf = PyMem_New(digit, 2 * na);
+        if (buf == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        memset(z, 0, (na + nb) * sizeof(digit));
+        for (i = 0; i < nb; i += na) {
+            Py_ssize_t nslice = Py_MIN(na, nb - i);
+            if (dec_mul(a, na, b + i, nslice, buf) < 0) {
+                PyMem_Free(buf);
+                return -1;
+            }
+            (void)dec_iadd(z + i, na + nb - i, buf, na + nslice);
+        }
+        PyMem_Free(buf);
         return 0;
+    }
+
+    /* Karatsuba, splitting a = ah*B**s + al and b = bh*B**s + bl:
+
+         a*b = ah*bh*B**2s + ((al+ah)*(bl+bh) - ah*bh - al*bl)*B**s + al*bl
+    */
+    nah = na - s;
+    nbh = nb - s;
+    buf = PyMem_New(digit, 4 * (s + 1));
+    if (buf == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    sa = buf;
+    sb = sa + (s + 1);
+    t = sb + (s + 1);
+    memcpy(sa, a, s * sizeof(digit));
+    sa[s] = dec_iadd(sa, s, a + s, nah);
+    memcpy(sb, b, s * sizeof(digit));
+    sb[s] = dec_iadd(sb, s, b + s, nbh);
+    if (dec_mul(a, s, b, s, z) < 0 ||
+        dec_mul(a + s, nah, b + s, nbh, z + 2 * s) < 0 ||
+        dec_mul(sa, s + 1, sb, s + 1, t) < 0) {
+        PyMem_Free(buf);
+        return -1;
+    }
+    nt = 2 * s + 2;
+    dec_isub(t, nt, z, 2 * s);
+    dec_isub(t, nt, z + 2 * s, nah + nbh);
+    while (nt > 0 && t[nt - 1] == 0) {
+        nt--;
+    }
+    assert(nt <= na + nb - s);
+    (void)dec_iadd(z + s, na + nb - s, t, nt);
+    PyMem_Free(buf);
+    return 0;
+}
+
+/* Return a*b + c for decimal scratch objects a, b and c, where c may be
+   NULL and is smaller than b. */
+static PyLongObject *
+dec_muladd(PyLongObject *a, PyLongObject *b, PyLongObject *c)
+{
+    Py_ssize_t size_a = Py_SIZE(a), size_b = Py_SIZE(b);
+    PyLongObject *z = _PyLong_New(size_a + size_b + 1);
+
+    if (z == NULL) {
+        return NULL;
+    }
+    if (dec_mul(a->ob_digit, size_a, b->ob_digit, size_b, z->ob_digit) < 0) {
+        Py_DECREF(z);
+        return NULL;
+    }
+    z->ob_digit[size_a + size_b] = 0;
+    if (c != NULL) {
+        assert(Py_SIZE(c) <= size_b);
+        (void)dec_iadd(z->ob_digit, size_a + size_b + 1,
+                       c->ob_digit, Py_SIZE(c));
+    }
+    return long_normalize(z);
+}
+
+/* Return 2**(PyLong_SHIFT*k) as a decimal scratch object. */
+static PyLongObject *
+dec_pow2(pow_cache *cache, Py_ssize_t k)
+{
+    PyLongObject *result, *a, *b;
+
+    result = pow_cache_get(cache, k);
+    if (result != NULL) {
+        return (PyLongObject *)Py_NewRef(result);
+    }
+    if (k <= DEC_CONVERSION_CUTOFF) {
+        digit *p = PyMem_Calloc(k + 1, sizeof(digit));
+        if (p == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        p[k] = 1;
+        result = long_to_decimal_digits(p, k + 1);
+        PyMem_Free(p);
+    }
+    else if ((a = pow_cache_get(cache, k - 1)) != NULL) {
+        b = dec_pow2(cache, 1);
+        if (b == NULL) {
+            return NULL;
+        }
+        result = dec_muladd(a, b, NULL);
+        Py_DECREF(b);
+    }
+    else {
+        /* If k is odd, k-k/2 is one larger than k/2.  Compute the smaller
+           one first, so that the larger one can use the branch above. */
+        a = dec_pow2(cache, k >> 1);
+        if (a == NULL) {
+            return NULL;
+        }
+        b = dec_pow2(cache, k - (k >> 1));
+        if (b == NULL) {
+            Py_DECREF(a);
+            return NULL;
+        }
+        result = dec_muladd(a, b, NULL);
+        Py_DECREF(a);
+        Py_DECREF(b);
+    }
+    if (result != NULL) {
+        pow_cache_put(cache, k, result);
+    }
+    return result;
+}
+
+/* Like long_to_decimal_digits(), but subquadratic for large inputs. */
+static PyLongObject *
+long_to_decimal_digits_dc(pow_cache *cache, const digit *pin, Py_ssize_t n)
+{
+    PyLongObject *lo, *hi, *p, *z;
+    Py_ssize_t k;
+
+    while (n > 0 && pin[n - 1] == 0) {
+        n--;
+    }
+    if (n <= DEC_CONVERSION_CUTOFF) {
+        return long_to_decimal_digits(pin, n);
+    }
+    k = n >> 1;
+    lo = long_to_decimal_digits_dc(cache, pin, k);
+    if (lo == NULL) {
+        return NULL;
+    }
+    hi = long_to_decimal_digits_dc(cache, pin + k, n - k);
+    if (hi == NULL) {
+        Py_DECREF(lo);
+        return NULL;
+    }
+    p = dec_pow2(cache, k);
+    if (p == NULL) {
+        Py_DECREF(lo);
+        Py_DECREF(hi);
+        return NULL;
+    }
+    z = dec_muladd(hi, p, lo);
+    Py_DECREF(lo);
+    Py_DECREF(hi);
+    Py_DECREF(p);
+    return z;
 }
-#endif /* WITH_PYLONG_MODULE */
 
 /* Convert an integer to a base 10 string.  Returns a new non-shared
    string.  (Return value is non-shared so that callers can modify the
@@ -1815,9 +2405,8 @@ long_to_decimal_string_internal(PyObject *aa,
     PyLongObject *scratch, *a;
     PyObject *str = NULL;
     Py_ssize_t size, strlen, size_a, i, j;
-    digit *pout, *pin, rem, tenpow;
+    digit *pout, rem, tenpow;
     int negative;
-    int d;
     int kind;
 
     a = (PyLongObject *)aa;
@@ -1841,67 +2430,22 @@ long_to_decimal_string_internal(PyObject *aa,
             (max_str_digits / (3 * PyLong_SHIFT) <= (size_a - 11) / 10)) {
             PyErr_Format(PyExc_ValueError, _MAX_STR_DIGITS_ERROR_FMT_TO_STR,
                          max_str_digits);
-            return -1;
-        }
-    }
-
-#if WITH_PYLONG_MODULE
-    if (size_a > 1000) {
-        /* Switch to _pylong.int_to_decimal_string(). */
-        return pylong_int_to_decimal_string(aa,
-                                         p_output,
-                                         writer,
-                                         bytes_writer,
-                                         bytes_str);
-    }
-#endif
-
-    /* quick and dirty upper bound for the number of digits
-       required to express a in base _PyLong_DECIMAL_BASE:
-
-         #digits = 1 + floor(log2(a) / log2(_PyLong_DECIMAL_BASE))
-
-       But log2(a) < size_a * PyLong_SHIFT, and
-       log2(_PyLong_DECIMAL_BASE) = log2(10) * _PyLong_DECIMAL_SHIFT
-                                  > 3.3 * _PyLong_DECIMAL_SHIFT
-
-         size_a * PyLong_SHIFT / (3.3 * _PyLong_DECIMAL_SHIFT) =
-             size_a + size_a / d < size_a + size_a / floor(d),
-       where d = (3.3 * _PyLong_DECIMAL_SHIFT) /
-                 (PyLong_SHIFT - 3.3 * _PyLong_DECIMAL_SHIFT)
-    */
-    d = (33 * _PyLong_DECIMAL_SHIFT) /
-        (10 * PyLong_SHIFT - 33 * _PyLong_DECIMAL_SHIFT);
-    assert(size_a < PY_SSIZE_T_MAX/2);
-    size = 1 + size_a + size_a / d;
-    scratch = _PyLong_New(size);
+            return -1;
+        }
+    }
+
+    if (size_a > DEC_CONVERSION_CUTOFF) {
+        pow_cache cache = {0};
+        scratch = long_to_decimal_digits_dc(&cache, a->ob_digit, size_a);
+        pow_cache_clear(&cache);
+    }
+    else {
+        scratch = long_to_decimal_digits(a->ob_digit, size_a);
+    }
     if (scratch == NULL)
         return -1;
-
-    /* convert array of base _PyLong_BASE digits in pin to an array of
-       base _PyLong_DECIMAL_BASE digits in pout, following Knuth (TAOCP,
-       Volume 2 (3rd edn), section 4.4, Method 1b). */
-    pin = a->ob_digit;
     pout = scratch->ob_digit;
-    size = 0;
-    for (i = size_a; --i >= 0; ) {
-        digit hi = pin[i];
-        for (j = 0; j < size; j++) {
-            twodigits z = (twodigits)pout[j] << PyLong_SHIFT | hi;
-            hi = (digit)(z / _PyLong_DECIMAL_BASE);
-            pout[j] = (digit)(z - (twodigits)hi *
-                              _PyLong_DECIMAL_BASE);
-        }
-        while (hi) {
-            pout[size++] = hi % _PyLong_DECIMAL_BASE;
-            hi /= _PyLong_DECIMAL_BASE;
-        }
-        /* check for keyboard interrupt */
-        SIGCHECK({
-                Py_DECREF(scratch);
-                return -1;
-            });
-    }
+    size = Py_SIZE(scratch);
     /* pout should have at least one digit, so that the case when a = 0
        works correctly */
     if (size == 0)
@@ -2354,47 +2898,14 @@ long_from_binary_base(const char *start, const char *end, Py_ssize_t digits, int
 
 static PyObject *long_neg(PyLongObject *v);
 
-#ifdef WITH_PYLONG_MODULE
-/* asymptotically faster str-to-long conversion for base 10, using _pylong.py */
-static int
-pylong_int_from_string(const char *start, const char *end, PyLongObject **res)
-{
-    PyObject *mod = PyImport_ImportModule("_pylong");
-    if (mod == NULL) {
-        goto error;
-    }
-    PyObject *s = PyUnicode_FromStringAndSize(start, end-start);
-    if (s == NULL) {
-        Py_DECREF(mod);
-        goto error;
-    }
-    PyObject *result = PyObject_CallMethod(mod, "int_from_string", "O", s);
-    Py_DECREF(s);
-    Py_DECREF(mod);
-    if (result == NULL) {
-        goto error;
-    }
-    if (!PyLong_Check(result)) {
-        Py_DECREF(result);
-        PyErr_SetString(PyExc_TypeError,
-                        "_pylong.int_from_string did not return an int");
-        goto error;
-    }
-    *res = (PyLongObject *)result;
-    return 0;
-error:
-    *res = NULL;
-    return 0;  // See the long_from_string_base() API comment.
-}
-#endif /* WITH_PYLONG_MODULE */
-
 /***
 long_from_non_binary_base: parameters and return values are the same as
 long_from_binary_base.
 
 Binary bases can be converted in time linear in the number of digits, because
 Python's representation base is binary.  Other bases (including decimal!) use
-the simple quadratic-time algorithm below, complicated by some speed tricks.
+the simple quadratic-time algorithm below, complicated by some speed tricks,
+for short strings; long_from_non_binary_base_dc() splits longer ones.
 
 First some math:  the largest integer that can be expressed in N base-B digits
 is B**N-1.  Consequently, if we have an N-digit input in base B, the worst-
@@ -2609,6 +3120,141 @@ long_from_non_binary_base(const char *start, const char *end, Py_ssize_t digits,
     return 0;
 }
 
+/* Subquadratic conversion from non-binary bases.
+
+   Strings of more than STR_CONVERSION_CUTOFF digits are split in two, and
+   the converted halves are recombined as hi * base**len(lo) + lo with the
+   subquadratic int multiplication.  That is the algorithm of
+   _pylong.int_from_string(), generalized to all non-binary bases: writing
+   base as odd * 2**shift, only odd**len(lo) is multiplied and the power of
+   two is applied with a shift, which is cheaper.  Pieces
+   of up to STR_CONVERSION_CUTOFF digits are converted with
+   long_from_non_binary_base(). */
+#define STR_CONVERSION_CUTOFF 1000
+
+/* Return base**exp. */
+static PyLongObject *
+long_base_pow(pow_cache *cache, int base, Py_ssize_t exp)
+{
+    PyLongObject *result, *a, *b;
+
+    result = pow_cache_get(cache, exp);
+    if (result != NULL) {
+        return (PyLongObject *)Py_NewRef(result);
+    }
+    if (exp == 1) {
+        result = (PyLongObject *)PyLong_FromLong(base);
+    }
+    else if ((a = pow_cache_get(cache, exp - 1)) != NULL) {
+        b = long_base_pow(cache, base, 1);
+        if (b == NULL) {
+            return NULL;
+        }
+        result = (PyLongObject *)_PyLong_Multiply(a, b);
+        Py_DECREF(b);
+    }
+    else {
+        /* If exp is odd, exp-exp/2 is one larger than exp/2.  Compute the
+           smaller one first, so that the larger one can use the branch
+           above. */
+        a = long_base_pow(cache, base, exp >> 1);
+        if (a == NULL) {
+            return NULL;
+        }
+        b = long_base_pow(cache, base, exp - (exp >> 1));
+        if (b == NULL) {
+            Py_DECREF(a);
+            return NULL;
+        }
+        result = (PyLongObject *)_PyLong_Multiply(a, b);
+        Py_DECREF(a);
+        Py_DECREF(b);
+    }
+    if (result != NULL) {
+        pow_cache_put(cache, exp, result);
+    }
+    return result;
+}
+
+/* Convert the n digits at start, which contain no underscores. */
+static PyLongObject *
+long_from_digits_dc(pow_cache *cache, const char *start, Py_ssize_t n,
+                    int base)
+{
+    PyLongObject *lo, *hi, *p, *z;
+    Py_ssize_t nlo;
+    int odd = base, shift = 0;
+
+    if (n <= STR_CONVERSION_CUTOFF) {
+        (void)long_from_non_binary_base(start, start + n, n, base, &z);
+        return z == NULL ? NULL : long_normalize(z);
+    }
+    nlo = n >> 1;
+    hi = long_from_digits_dc(cache, start, n - nlo, base);
+    if (hi == NULL) {
+        return NULL;
+    }
+    lo = long_from_digits_dc(cache, start + n - nlo, nlo, base);
+    if (lo == NULL) {
+        Py_DECREF(hi);
+        return NULL;
+    }
+    while ((odd & 1) == 0) {
+        odd >>= 1;
+        shift++;
+    }
+    p = long_base_pow(cache, odd, nlo);
+    if (p == NULL) {
+        Py_DECREF(hi);
+        Py_DECREF(lo);
+        return NULL;
+    }
+    z = (PyLongObject *)_PyLong_Multiply(hi, p);
+    Py_DECREF(hi);
+    Py_DECREF(p);
+    if (z != NULL && shift) {
+        Py_SETREF(z, (PyLongObject *)_PyLong_Lshift((PyObject *)z,
+                                                    (size_t)shift * nlo));
+    }
+    if (z != NULL) {
+        Py_SETREF(z, (PyLongObject *)_PyLong_Add(z, lo));
+    }
+    Py_DECREF(lo);
+    return z;
+}
+
+/* Same parameters and return values as long_from_non_binary_base(), but
+   subquadratic for long strings.  Leading zeros are dropped first, so that
+   the result is never a shared small int. */
+static int
+long_from_non_binary_base_dc(const char *start, const char *end,
+                             Py_ssize_t digits, int base, PyLongObject **res)
+{
+    pow_cache cache = {0};
+    const char *p;
+    char *buf, *q;
+
+    buf = PyMem_Malloc(digits);
+    if (buf == NULL) {
+        PyErr_NoMemory();
+        *res = NULL;
+        return 0;
+    }
+    q = buf;
+    for (p = start; p < end; p++) {
+        if (*p != '_' && (*p != '0' || q != buf)) {
+            *q++ = *p;
+        }
+    }
+    if (q == buf) {
+        *q++ = '0';
+    }
+    *res = long_from_digits_dc(&cache, buf, q - buf, base);
+    pow_cache_clear(&cache);
+    PyMem_Free(buf);
+    return 0;
+}
+
 /* *str points to the first digit in a string of base `base` digits. base is an
  * integer from 2 to 36 inclusive. Here we don't need to worry about prefixes
  * like 0x or leading +- signs. The string should be null terminated consisting
@@ -2617,13 +3263,12 @@ long_from_non_binary_base(const char *start, const char *end, Py_ssize_t digits,
  *
  * If base is a power of 2 then the complexity is linear in the number of
  * characters in the string. Otherwise a quadratic algorithm is used for
- * non-binary bases.
+ * short strings and a subquadratic one for long strings.
  *
  * Return values:
  *
  *   - Returns -1 on syntax error (exception needs to be set, *res is untouched)
- *   - Returns 0 and sets *res to NULL for MemoryError, OverflowError, or
- *     _pylong.int_from_string() errors.
+ *   - Returns 0 and sets *res to NULL for MemoryError or OverflowError.
  *   - Returns 0 and sets *res to an unsigned, unnormalized PyLong (success!).
  *
  * Afterwards *str is set to point to the first non-digit (which may be *str!).
@@ -2702,13 +3347,11 @@ long_from_string_base(const char **str, int base, PyLongObject **res)
                 return 0;
             }
         }
-#if WITH_PYLONG_MODULE
-        if (digits > 6000 && base == 10) {
-            /* Switch to _pylong.int_from_string() */
-            return pylong_int_from_string(start, end, res);
+        if (digits > STR_CONVERSION_CUTOFF) {
+            /* Use the subquadratic algorithm for long strings. */
+            return long_from_non_binary_base_dc(start, end, digits, base, res);
         }
-#endif
-        /* Use the quadratic algorithm for non binary bases. */
+        /* Use the quadratic algorithm for short ones. */
         return long_from_non_binary_base(start, end, digits, base, res);
     }
 }
@@ -2994,11 +3637,12 @@ long_rem(PyLongObject *a, PyLongObject *b, PyLongObject **prem)
     return 0;
 }
 
-/* Unsigned int division with remainder -- the algorithm.  The arguments v1
-   and w1 should satisfy 2 <= Py_ABS(Py_SIZE(w1)) <= Py_ABS(Py_SIZE(v1)). */
+/* Unsigned int division with remainder -- the schoolbook algorithm.  The
+   arguments v1 and w1 should satisfy
+   2 <= Py_ABS(Py_SIZE(w1)) <= Py_ABS(Py_SIZE(v1)). */
 
 static PyLongObject *
-x_divrem(PyLongObject *v1, PyLongObject *w1, PyLongObject **prem)
+x_divrem_knuth(PyLongObject *v1, PyLongObject *w1, PyLongObject **prem)
 {
     PyLongObject *v, *w, *a;
     Py_ssize_t i, k, size_v, size_w;
@@ -3128,6 +3772,181 @@ x_divrem(PyLongObject *v1, PyLongObject *w1, PyLongObject **prem)
     return long_normalize(a);
 }
 
+/* Division by Newton's method.
+
+   For a large divisor w of n bits and a large quotient, x_divrem() computes
+   an approximation R of 2**(n+k)/w, with k a few bits more than the
+   quotient has, multiplies the dividend by it and shifts, so that division
+   costs a few multiplications.  R is built by Newton's iteration for the
+   reciprocal, R' = 2*R - w*R**2/2**(n+k), which doubles its precision at
+   each step, using only as many top bits of w as the precision calls for.
+   The quotient estimate is then off by at most a few units, which the
+   remainder reveals and a few additions fix. */
+
+/* x_divrem() uses Newton's method when both the divisor and the quotient
+   have at least NEWTON_DIV_CUTOFF digits. */
+#define NEWTON_DIV_CUTOFF 700
+
+/* Extra bits carried through the iteration to absorb truncation errors. */
+#define NEWTON_GUARD_BITS 8
+
+/* Reciprocals of at most this many bits are computed with
+   x_divrem_knuth().  Their quotients are too short to recurse into
+   x_divrem_newton(). */
+#define NEWTON_BASE_BITS (100 * PyLong_SHIFT)
+
+static PyObject *long_abs(PyLongObject *v);
+static Py_ssize_t long_compare(PyLongObject *a, PyLongObject *b);
+
+/* Return an approximation of 2**(n+k)/w, where w > 0 has n bits. */
+static PyLongObject *
+newton_reciprocal(PyLongObject *w, int64_t n, int64_t k)
+{
+    int64_t s = Py_MAX(n - k - NEWTON_GUARD_BITS, 0);
+    int64_t h;
+    PyLongObject *wt, *y, *t, *u, *result = NULL;
+
+    /* The top bits of w: w is about wt * 2**s. */
+    wt = (PyLongObject *)_PyLong_Rshift((PyObject *)w, (size_t)s);
+    if (wt == NULL) {
+        return NULL;
+    }
+    if (k <= NEWTON_BASE_BITS) {
+        PyLongObject *rem;
+        t = (PyLongObject *)_PyLong_Lshift(_PyLong_GetOne(),
+                                           (size_t)(n - s + k));
+        if (t != NULL) {
+            result = x_divrem_knuth(t, wt, &rem);
+            if (result != NULL) {
+                Py_DECREF(rem);
+            }
+            Py_DECREF(t);
+        }
+        Py_DECREF(wt);
+        return result;
+    }
+
+    /* y is about 2**(n+h)/w; result = y*2**(k-h+1) - wt*y**2 >> shift. */
+    h = (k >> 1) + NEWTON_GUARD_BITS;
+    y = newton_reciprocal(w, n, h);
+    if (y == NULL) {
+        Py_DECREF(wt);
+        return NULL;
+    }
+    t = (PyLongObject *)_PyLong_Multiply(wt, y);
+    Py_DECREF(wt);
+    if (t != NULL) {
+        Py_SETREF(t, (PyLongObject *)_PyLong_Multiply(t, y));
+    }
+    if (t != NULL) {
+        Py_SETREF(t, (PyLongObject *)_PyLong_Rshift(
+            (PyObject *)t, (size_t)(n - s + 2*h - k)));
+    }
+    if (t != NULL) {
+        u = (PyLongObject *)_PyLong_Lshift((PyObject *)y,
+                                           (size_t)(k - h + 1));
+        if (u != NULL) {
+            result = (PyLongObject *)_PyLong_Subtract(u, t);
+            Py_DECREF(u);
+        }
+        Py_DECREF(t);
+    }
+    Py_DECREF(y);
+    return result;
+}
+
+/* Same as x_divrem_knuth(), in a few multiplications' time. */
+static PyLongObject *
+x_divrem_newton(PyLongObject *v1, PyLongObject *w1, PyLongObject **prem)
+{
+    PyLongObject *v, *w, *q = NULL, *r = NULL, *t, *vt;
+    PyLongObject *one = (PyLongObject *)_PyLong_GetOne();
+    int64_t n, k, s;
+
+    v = (PyLongObject *)long_abs(v1);
+    if (v == NULL) {
+        return NULL;
+    }
+    w = (PyLongObject *)long_abs(w1);
+    if (w == NULL) {
+        Py_DECREF(v);
+        return NULL;
+    }
+    n = (int64_t)_PyLong_NumBits((PyObject *)w);
+    k = (int64_t)_PyLong_NumBits((PyObject *)v) - n + 1 + NEWTON_GUARD_BITS;
+
+    /* q = (v >> s) * R >> (n + k - s), where the bits of v dropped by the
+       first shift can't change the estimate by more than a unit. */
+    t = newton_reciprocal(w, n, k);
+    if (t == NULL) {
+        goto error;
+    }
+    s = Py_MAX(n - NEWTON_GUARD_BITS, 0);
+    vt = (PyLongObject *)_PyLong_Rshift((PyObject *)v, (size_t)s);
+    if (vt != NULL) {
+        q = (PyLongObject *)_PyLong_Multiply(vt, t);
+        Py_DECREF(vt);
+    }
+    Py_DECREF(t);
+    if (q != NULL) {
+        Py_SETREF(q, (PyLongObject *)_PyLong_Rshift((PyObject *)q,
+                                                    (size_t)(n + k - s)));
+    }
+    if (q == NULL) {
+        goto error;
+    }
+
+    /* r = v - q*w, then bring r into [0, w). */
+    t = (PyLongObject *)_PyLong_Multiply(q, w);
+    if (t == NULL) {
+        goto error;
+    }
+    r = (PyLongObject *)_PyLong_Subtract(v, t);
+    Py_DECREF(t);
+    if (r == NULL) {
+        goto error;
+    }
+    while (Py_SIZE(r) < 0) {
+        Py_SETREF(q, (PyLongObject *)_PyLong_Subtract(q, one));
+        Py_SETREF(r, (PyLongObject *)_PyLong_Add(r, w));
+        if (q == NULL || r == NULL) {
+            goto error;
+        }
+    }
+    while (long_compare(r, w) >= 0) {
+        Py_SETREF(q, (PyLongObject *)_PyLong_Add(q, one));
+        Py_SETREF(r, (PyLongObject *)_PyLong_Subtract(r, w));
+        if (q == NULL || r == NULL) {
+            goto error;
+        }
+    }
+    Py_DECREF(v);
+    Py_DECREF(w);
+    *prem = r;
+    return q;
+
+  error:
+    Py_XDECREF(q);
+    Py_XDECREF(r);
+    Py_DECREF(v);
+    Py_DECREF(w);
+    return NULL;
+}
+
+/* Unsigned int division with remainder.  The arguments v1 and w1 should
+   satisfy 2 <= Py_ABS(Py_SIZE(w1)) <= Py_ABS(Py_SIZE(v1)). */
+
+static PyLongObject *
+x_divrem(PyLongObject *v1, PyLongObject *w1, PyLongObject **prem)
+{
+    Py_ssize_t size_v = Py_ABS(Py_SIZE(v1)), size_w = Py_ABS(Py_SIZE(w1));
+
+    if (size_w >= NEWTON_DIV_CUTOFF && size_v - size_w >= NEWTON_DIV_CUTOFF) {
+        return x_divrem_newton(v1, w1, prem);
+    }
+    return x_divrem_knuth(v1, w1, prem);
+}
+
 /* For a nonzero PyLong a, express a in the form x * 2**e, with 0.5 <=
    abs(x) < 1.0 and e >= 0; return x and put e in *e.  Here x is
    rounded to DBL_MANT_DIG significant bits using round-half-to-even.
@@ -3681,6 +4500,203 @@ kmul_split(PyLongObject *n,
 
 static PyLongObject *k_lopsided_mul(PyLongObject *a, PyLongObject *b);
 
+/* Multiply the absolute values of two ints with ntt_mul_digits(). */
+static PyLongObject *
+ntt_mul(PyLongObject *a, PyLongObject *b)
+{
+    Py_ssize_t asize = Py_ABS(Py_SIZE(a));
+    Py_ssize_t bsize = Py_ABS(Py_SIZE(b));
+    PyLongObject *ret = _PyLong_New(asize + bsize);
+
+    if (ret == NULL)
+        return NULL;
+    if (ntt_mul_digits(a->ob_digit, asize, b->ob_digit, bsize,
+                       ret->ob_digit, PyLong_BASE) < 0) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return long_normalize(ret);
+}
+
+/* Split the absolute value of n into three pieces of size digits, from
+ * the least significant: n = parts[2]*X**2 + parts[1]*X + parts[0] with
+ * X = BASE**size.
+ */
+static int
+toom3_split(PyLongObject *n, Py_ssize_t size, PyLongObject *parts[3])
+{
+    PyLongObject *hi;
+
+    if (kmul_split(n, size, &hi, &parts[0]) < 0)
+        return -1;
+    if (kmul_split(hi, size, &parts[2], &parts[1]) < 0) {
+        Py_DECREF(hi);
+        Py_CLEAR(parts[0]);
+        return -1;
+    }
+    Py_DECREF(hi);
+    return 0;
+}
+
+/* Evaluate x2*t**2 + x1*t + x0 at t = 0, 1, -1, -2 and infinity. */
+static int
+toom3_evaluate(PyLongObject *x[3], PyLongObject *values[5])
+{
+    PyLongObject *p, *t;
+
+    if ((p = (PyLongObject *)_PyLong_Add(x[0], x[2])) == NULL)
+        return -1;
+    values[1] = (PyLongObject *)_PyLong_Add(p, x[1]);
+    values[2] = (PyLongObject *)_PyLong_Subtract(p, x[1]);
+    Py_DECREF(p);
+    if (values[1] == NULL || values[2] == NULL)
+        goto fail;
+    if ((p = (PyLongObject *)_PyLong_Add(values[2], x[2])) == NULL)
+        goto fail;
+    t = (PyLongObject *)_PyLong_Lshift((PyObject *)p, 1);
+    Py_DECREF(p);
+    if (t == NULL)
+        goto fail;
+    values[3] = (PyLongObject *)_PyLong_Subtract(t, x[0]);
+    Py_DECREF(t);
+    if (values[3] == NULL)
+        goto fail;
+    values[0] = (PyLongObject *)Py_NewRef(x[0]);
+    values[4] = (PyLongObject *)Py_NewRef(x[2]);
+    return 0;
+
+  fail:
+    Py_CLEAR(values[1]);
+    Py_CLEAR(values[2]);
+    return -1;
+}
+
+/* Exact division by 3, keeping the sign. */
+static PyLongObject *
+toom3_divexact3(PyLongObject *x)
+{
+    digit rem;
+    PyLongObject *q = divrem1(x, 3, &rem);
+
+    assert(rem == 0);
+    if (q != NULL && Py_SIZE(x) < 0)
+        Py_SET_SIZE(q, -Py_SIZE(q));
+    return q;
+}
+
+/* Toom-3 multiplication.  Ignores the input signs, and returns the
+ * absolute value of the product (or NULL if error).  Requires
+ * asize <= bsize < 2*asize.
+ *
+ * With X = BASE**k, a = a2*X**2 + a1*X + a0 and b likewise, the product
+ * polynomial r is evaluated at 0, 1, -1, -2 and infinity with five
+ * multiplications of numbers a third of the size, instead of the nine of
+ * two levels of Karatsuba, and interpolated with Bodrato's sequence, in
+ * which the divisions are exact:
+ *
+ *     r3 = (r(-2) - r(1)) / 3
+ *     r1 = (r(1) - r(-1)) / 2
+ *     r2 = r(-1) - r(0)
+ *     r3 = (r2 - r3) / 2 + 2*r(inf)
+ *     r2 = r2 + r1 - r(inf)
+ *     r1 = r1 - r3
+ */
+static PyLongObject *
+toom3_mul(PyLongObject *a, PyLongObject *b)
+{
+    Py_ssize_t asize = Py_ABS(Py_SIZE(a));
+    Py_ssize_t bsize = Py_ABS(Py_SIZE(b));
+    Py_ssize_t k = (bsize + 2) / 3;
+    PyLongObject *pa[3] = {NULL, NULL, NULL};
+    PyLongObject *pb[3] = {NULL, NULL, NULL};
+    PyLongObject *ea[5] = {NULL, NULL, NULL, NULL, NULL};
+    PyLongObject *eb[5] = {NULL, NULL, NULL, NULL, NULL};
+    PyLongObject *r[5] = {NULL, NULL, NULL, NULL, NULL};
+    PyLongObject *t, *t2, *ret = NULL;
+    int i;
+
+    assert(asize <= bsize && bsize < 2 * asize);
+    if (toom3_split(a, k, pa) < 0 || toom3_evaluate(pa, ea) < 0)
+        goto done;
+    if (a == b) {
+        for (i = 0; i < 5; i++)
+            eb[i] = (PyLongObject *)Py_NewRef(ea[i]);
+    }
+    else if (toom3_split(b, k, pb) < 0 || toom3_evaluate(pb, eb) < 0)
+        goto done;
+    for (i = 0; i < 5; i++) {
+        if ((r[i] = (PyLongObject *)_PyLong_Multiply(ea[i], eb[i])) == NULL)
+            goto done;
+    }
+
+    /* r[0..4] hold r(0), r(1), r(-1), r(-2), r(inf); interpolate them in
+       place into the coefficients of r. */
+    if ((t = (PyLongObject *)_PyLong_Subtract(r[3], r[1])) == NULL)
+        goto done;
+    Py_SETREF(r[3], toom3_divexact3(t));
+    Py_DECREF(t);
+    if (r[3] == NULL)
+        goto done;
+    if ((t = (PyLongObject *)_PyLong_Subtract(r[1], r[2])) == NULL)
+        goto done;
+    Py_SETREF(r[1], (PyLongObject *)_PyLong_Rshift((PyObject *)t, 1));
+    Py_DECREF(t);
+    if (r[1] == NULL)
+        goto done;
+    Py_SETREF(r[2], (PyLongObject *)_PyLong_Subtract(r[2], r[0]));
+    if (r[2] == NULL)
+        goto done;
+    if ((t = (PyLongObject *)_PyLong_Subtract(r[2], r[3])) == NULL)
+        goto done;
+    t2 = (PyLongObject *)_PyLong_Rshift((PyObject *)t, 1);
+    Py_DECREF(t);
+    if (t2 == NULL)
+        goto done;
+    t = (PyLongObject *)_PyLong_Lshift((PyObject *)r[4], 1);
+    if (t == NULL) {
+        Py_DECREF(t2);
+        goto done;
+    }
+    Py_SETREF(r[3], (PyLongObject *)_PyLong_Add(t2, t));
+    Py_DECREF(t);
+    Py_DECREF(t2);
+    if (r[3] == NULL)
+        goto done;
+    if ((t = (PyLongObject *)_PyLong_Add(r[2], r[1])) == NULL)
+        goto done;
+    Py_SETREF(r[2], (PyLongObject *)_PyLong_Subtract(t, r[4]));
+    Py_DECREF(t);
+    if (r[2] == NULL)
+        goto done;
+    Py_SETREF(r[1], (PyLongObject *)_PyLong_Subtract(r[1], r[3]));
+    if (r[1] == NULL)
+        goto done;
+
+    /* The coefficients are nonnegative; add them up at their offsets. */
+    if ((ret = _PyLong_New(asize + bsize)) == NULL)
+        goto done;
+    memset(ret->ob_digit, 0, (asize + bsize) * sizeof(digit));
+    for (i = 0; i < 5; i++) {
+        assert(Py_SIZE(r[i]) >= 0);
+        assert(i * k + Py_SIZE(r[i]) <= asize + bsize);
+        (void)v_iadd(ret->ob_digit + i * k, asize + bsize - i * k,
+                     r[i]->ob_digit, Py_SIZE(r[i]));
+    }
+    ret = long_normalize(ret);
+
+  done:
+    for (i = 0; i < 3; i++) {
+        Py_XDECREF(pa[i]);
+        Py_XDECREF(pb[i]);
+    }
+    for (i = 0; i < 5; i++) {
+        Py_XDECREF(ea[i]);
+        Py_XDECREF(eb[i]);
+        Py_XDECREF(r[i]);
+    }
+    return ret;
+}
+
 /* Karatsuba multiplication.  Ignores the input signs, and returns the
  * absolute value of the product (or NULL if error).
  * See Knuth Vol. 2 Chapter 4.3.3 (Pp. 294-295).
@@ -3729,6 +4745,12 @@ k_mul(PyLongObject *a, PyLongObject *b)
             return x_mul(a, b);
     }
 
+    /* Huge operands are multiplied with number-theoretic transforms, which
+     * also handle unbalanced sizes well.
+     */
+    if (asize >= NTT_CUTOFF && asize + bsize <= ((Py_ssize_t)1 << NTT_MAX_LOG))
+        return ntt_mul(a, b);
+
     /* If a is small compared to b, splitting on b gives a degenerate
      * case with ah==0, and Karatsuba may be (even much) less efficient
      * than "grade school" then.  However, we can still win, by viewing
@@ -3738,6 +4760,12 @@ k_mul(PyLongObject *a, PyLongObject *b)
     if (2 * asize <= bsize)
         return k_lopsided_mul(a, b);
 
+    /* Toom-3 needs fewer multiplications than Karatsuba once they are
+     * big enough to amortize its longer evaluation and interpolation.
+     */
+    if (asize >= (a == b ? TOOM3_SQUARE_CUTOFF : TOOM3_CUTOFF))
+        return toom3_mul(a, b);
+
     /* Split a & b into hi & lo pieces. */
     shift = bsize >> 1;
     if (kmul_split(a, shift, &ah, &al) < 0) goto fail;
@@ -4031,46 +5059,6 @@ fast_floor_div(PyLongObject *a, PyLongObject *b)
     return PyLong_FromLong(div);
 }
 
-#ifdef WITH_PYLONG_MODULE
-/* asymptotically faster divmod, using _pylong.py */
-static int
-pylong_int_divmod(PyLongObject *v, PyLongObject *w,
-                  PyLongObject **pdiv, PyLongObject **pmod)
-{
-    PyObject *mod = PyImport_ImportModule("_pylong");
-    if (mod == NULL) {
-        return -1;
-    }
-    PyObject *result = PyObject_CallMethod(mod, "int_divmod", "OO", v, w);
-    Py_DECREF(mod);
-    if (result == NULL) {
-        return -1;
-    }
-    if (!PyTuple_Check(result)) {
-        Py_DECREF(result);
-        PyErr_SetString(PyExc_ValueError,
-                        "tuple is required from int_divmod()");
-        return -1;
-    }
-    PyObject *q = PyTuple_GET_ITEM(result, 0);
-    PyObject *r = PyTuple_GET_ITEM(result, 1);
-    if (!PyLong_Check(q) || !PyLong_Check(r)) {
-        Py_DECREF(result);
-        PyErr_SetString(PyExc_ValueError,
-                        "tuple of int is required from int_divmod()");
-        return -1;
-    }
-    if (pdiv != NULL) {
-        *pdiv = (PyLongObject *)Py_NewRef(q);
-    }
-    if (pmod != NULL) {
-        *pmod = (PyLongObject *)Py_NewRef(r);
-    }
-    Py_DECREF(result);
-    return 0;
-}
-#endif /* WITH_PYLONG_MODULE */
-
 /* The / and % operators are now defined in terms of divmod().
    The expression a mod b has the value a - b*floor(a/b).
    The long_divrem function gives the remainder after division of
@@ -4122,18 +5110,6 @@ l_divmod(PyLongObject *v, PyLongObject *w,
         }
         return 0;
     }
-#if WITH_PYLONG_MODULE
-    Py_ssize_t size_v = Py_ABS(Py_SIZE(v)); /* digits in numerator */
-    Py_ssize_t size_w = Py_ABS(Py_SIZE(w)); /* digits in denominator */
-    if (size_w > 300 && (size_v - size_w) > 150) {
-        /* Switch to _pylong.int_divmod().  If the quotient is small then
-          "schoolbook" division is linear-time so don't use in that case.
-          These limits are empirically determined and should be slightly
-          conservative so that _pylong is used in cases it is likely
-          to be faster. See Tools/scripts/divmod_threshold.py. */
-        return pylong_int_divmod(v, w, pdiv, pmod);
-    }
-#endif
     if (long_divrem(v, w, &div, &mod) < 0)
         return -1;
     if ((Py_SIZE(mod) < 0 && Py_SIZE(w) > 0) ||
@@ -3,6 +3,7 @@
 
 #include "Python.h"
 #include "pycore_call.h"          // _PyObject_CallNoArgs()
+#include "pycore_critical_section.h"  // Py_BEGIN_CRITICAL_SECTION()
 #include "pycore_interp.h"        // PyInterpreterState.importlib
 #include "pycore_object.h"        // _PyType_AllocNoTrack
 #include "pycore_pystate.h"       // _PyInterpreterState_GET()
@@ -105,6 +106,8 @@ new_module_notrack(PyTypeObject *mt)
     m->md_state = NULL;
     m->md_weaklist = NULL;
     m->md_name = NULL;
+    m->md_lazy = NULL;
+    m->md_lazy_owner = 0;
     m->md_dict = PyDict_New();
     if (m->md_dict != NULL) {
         PyObject_GC_Track(m->md_dict);
@@ -728,6 +731,7 @@ module_dealloc(PyModuleObject *m)
     }
     Py_XDECREF(m->md_dict);
     Py_XDECREF(m->md_name);
+    Py_XDECREF(m->md_lazy);
     if (m->md_state != NULL)
         PyMem_Free(m->md_state);
     Py_TYPE(m)->tp_free((PyObject *)m);
@@ -784,10 +788,224 @@ _PyModuleSpec_IsUninitializedSubmodule(PyObject *spec, PyObject *name)
     return is_uninitialized;
 }
 
+/* Lazy modules
+
+   importlib.util.LazyLoader executes the module normally done by
+   exec_module() on the first access to one of its attributes.  Until then
+   md_lazy holds a copy of the module dict, so that attributes set on the
+   lazy module can be restored after it is executed, as if it had been
+   loaded eagerly.
+
+   The first thread to access an attribute executes the module while
+   holding its import lock, with __spec__._initializing set, as importlib
+   does for an eager import.  Other threads wait on that lock, so a
+   deadlock between imports made by the module code and other threads is
+   detected by importlib, and the module is then seen partially
+   initialized.  The attribute accesses made by the module code itself go
+   through. */
+
+/* Make the module lazy.  Return a new reference to the copy of its dict,
+   or NULL with an exception set. */
+PyObject *
+_PyModule_SetLazy(PyObject *self)
+{
+    assert(PyModule_Check(self));
+    PyModuleObject *m = (PyModuleObject *)self;
+    PyObject *attrs = PyDict_Copy(m->md_dict);
+    if (attrs == NULL) {
+        return NULL;
+    }
+    Py_XDECREF(_Py_atomic_exchange_ptr(&m->md_lazy, Py_NewRef(attrs)));
+    return attrs;
+}
+
+static int
+module_exec_lazy(PyModuleObject *m, PyObject *spec, PyObject *name,
+                 PyObject *attrs_then)
+{
+    PyObject *dict = m->md_dict;
+    PyObject *loader, *attrs_updated = NULL;
+    int res = -1;
+
+    loader = PyObject_GetAttr(spec, &_Py_ID(loader));
+    if (loader == NULL) {
+        return -1;
+    }
+
+    /* Figure out exactly what attributes were mutated since the module was
+       made lazy.  Code that set the attribute may have kept a reference to
+       the assigned object, making identity more important than equality. */
+    attrs_updated = PyDict_New();
+    if (attrs_updated == NULL) {
+        goto done;
+    }
+    int err = 0;
+    Py_BEGIN_CRITICAL_SECTION(dict);
+    Py_ssize_t pos = 0;
+    PyObject *key, *value;
+    while (PyDict_Next(dict, &pos, &key, &value)) {
+        PyObject *old = PyDict_GetItemWithError(attrs_then, key);
+        if ((old == NULL && PyErr_Occurred()) ||
+            (old != value && PyDict_SetItem(attrs_updated, key, value) < 0))
+        {
+            err = -1;
+            break;
+        }
+    }
+    Py_END_CRITICAL_SECTION;
+    if (err < 0) {
+        goto done;
+    }
+
+    PyObject *r = PyObject_CallMethodOneArg(loader, &_Py_ID(exec_module),
+                                            (PyObject *)m);
+    if (r == NULL) {
+        goto done;
+    }
+    Py_DECREF(r);
+
+    /* If exec_module() was used directly there is no guarantee the module
+       object was put into sys.modules. */
+    PyObject *modules = PyImport_GetModuleDict();
+    PyObject *mod = PyDict_GetItemWithError(modules, name);
+    if (mod == NULL && PyErr_Occurred()) {
+        goto done;
+    }
+    if (mod != NULL && mod != (PyObject *)m) {
+        PyErr_Format(PyExc_ValueError,
+                     "module object for %R substituted in sys.modules "
+                     "during a lazy load", name);
+        goto done;
+    }
+    /* Update after loading since that's what would happen in an eager
+       loading situation. */
+    res = PyDict_Update(dict, attrs_updated);
+
+done:
+    Py_DECREF(loader);
+    Py_XDECREF(attrs_updated);
+    return res;
+}
+
+/* Acquire the import lock of the module called name.  Return the lock, or
+   Py_None if waiting for it would deadlock, or NULL with an exception set. */
+static PyObject *
+module_lock_acquire(PyObject *name)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    PyObject *lock = PyObject_CallMethod(interp->importlib,
+                                         "_get_module_lock", "O", name);
+    if (lock == NULL) {
+        return NULL;
+    }
+    PyObject *r = PyObject_CallMethod(lock, "acquire", NULL);
+    if (r != NULL) {
+        Py_DECREF(r);
+        return lock;
+    }
+    Py_DECREF(lock);
+    PyObject *exc, *val, *tb;
+    PyErr_Fetch(&exc, &val, &tb);
+    PyObject *deadlock_error = PyObject_GetAttrString(interp->importlib,
+                                                      "_DeadlockError");
+    if (deadlock_error == NULL) {
+        _PyErr_ChainExceptions(exc, val, tb);
+        return NULL;
+    }
+    int match = PyErr_GivenExceptionMatches(exc, deadlock_error);
+    Py_DECREF(deadlock_error);
+    if (!match) {
+        PyErr_Restore(exc, val, tb);
+        return NULL;
+    }
+    /* Concurrent circular import, accept a partially initialized module */
+    Py_DECREF(exc);
+    Py_XDECREF(val);
+    Py_XDECREF(tb);
+    Py_RETURN_NONE;
+}
+
+/* Load the module if it is lazy.  Return 0 on success, or -1 with an
+   exception set if executing the module failed. */
+static int
+module_load_lazy(PyModuleObject *m)
+{
+    if (_Py_atomic_load_ptr(&m->md_lazy) == NULL ||
+        _Py_atomic_load_uintptr(&m->md_lazy_owner) == _Py_ThreadId())
+    {
+        return 0;
+    }
+
+    /* All module metadata must be garnered from __spec__ in order to avoid
+       using mutated values. */
+    PyObject *spec = PyDict_GetItemWithError(m->md_dict, &_Py_ID(__spec__));
+    if (spec == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_AttributeError,
+                            "lazy module has no attribute '__spec__'");
+        }
+        return -1;
+    }
+    Py_INCREF(spec);
+    int res = -1;
+    PyObject *lock = NULL;
+    PyObject *name = PyObject_GetAttr(spec, &_Py_ID(name));
+    if (name == NULL) {
+        goto done;
+    }
+    lock = module_lock_acquire(name);
+    if (lock == NULL) {
+        goto done;
+    }
+    res = 0;
+    if (lock == Py_None) {
+        goto done;
+    }
+    /* attrs_then is NULL if another thread loaded the module while we
+       waited for the lock */
+    PyObject *exc, *val, *tb;
+    PyObject *attrs_then = _Py_atomic_load_ptr(&m->md_lazy);
+    if (attrs_then != NULL) {
+        if (PyObject_SetAttr(spec, &_Py_ID(_initializing), Py_True) < 0) {
+            res = -1;
+            goto release;
+        }
+        /* The module is loaded only once, even if executing it fails */
+        _Py_atomic_store_uintptr(&m->md_lazy_owner, _Py_ThreadId());
+        res = module_exec_lazy(m, spec, name, attrs_then);
+        _Py_atomic_store_ptr(&m->md_lazy, NULL);
+        _Py_atomic_store_uintptr(&m->md_lazy_owner, 0);
+        Py_DECREF(attrs_then);
+
+        PyErr_Fetch(&exc, &val, &tb);
+        if (PyObject_SetAttr(spec, &_Py_ID(_initializing), Py_False) < 0) {
+            res = -1;
+        }
+        _PyErr_ChainExceptions(exc, val, tb);
+    }
+release:
+    PyErr_Fetch(&exc, &val, &tb);
+    PyObject *r = PyObject_CallMethod(lock, "release", NULL);
+    if (r == NULL) {
+        res = -1;
+    }
+    Py_XDECREF(r);
+    _PyErr_ChainExceptions(exc, val, tb);
+
+done:
+    Py_DECREF(spec);
+    Py_XDECREF(name);
+    Py_XDECREF(lock);
+    return res;
+}
+
 static PyObject*
 module_getattro(PyModuleObject *m, PyObject *name)
 {
     PyObject *attr, *mod_name, *getattr;
+    if (module_load_lazy(m) < 0) {
+        return NULL;
+    }
     attr = PyObject_GenericGetAttr((PyObject *)m, name);
     if (attr || !PyErr_ExceptionMatches(PyExc_AttributeError)) {
         return attr;
@@ -840,6 +1058,17 @@ module_getattro(PyModuleObject *m, PyObject *name)
     return NULL;
 }
 
+static int
+module_setattro(PyModuleObject *m, PyObject *name, PyObject *value)
+{
+    /* Deleting an attribute loads a lazy module, to raise AttributeError
+       if it does not exist */
+    if (value == NULL && module_load_lazy(m) < 0) {
+        return -1;
+    }
+    return PyObject_GenericSetAttr((PyObject *)m, name, value);
+}
+
 static int
 module_traverse(PyModuleObject *m, visitproc visit, void *arg)
 {
@@ -852,6 +1081,7 @@ module_traverse(PyModuleObject *m, visitproc visit, void *arg)
             return res;
     }
     Py_VISIT(m->md_dict);
+    Py_VISIT(m->md_lazy);
     return 0;
 }
 
@@ -873,6 +1103,7 @@ module_clear(PyModuleObject *m)
             return res;
     }
     Py_CLEAR(m->md_dict);
+    Py_CLEAR(m->md_lazy);
     return 0;
 }
 
@@ -998,7 +1229,7 @@ PyTypeObject PyModule_Type = {
     0,                                          /* tp_call */
     0,                                          /* tp_str */
     (getattrofunc)module_getattro,              /* tp_getattro */
-    PyObject_GenericSetAttr,                    /* tp_setattro */
+    (setattrofunc)module_setattro,              /* tp_setattro */
     0,                                          /* tp_as_buffer */
     Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
         Py_TPFLAGS_BASETYPE,                    /* tp_flags */
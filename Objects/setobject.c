@@ -29,14 +29,22 @@
    about membership testing where the presence of an element is not known in
    advance.  Accordingly, the set implementation needs to optimize for both
    the found and not-found case.
+
+   As in Objects/dictobject.c, the table is compact: the entries are stored
+   densely in insertion order, and a separate index array of 1, 2, 4 or
+   8 byte slots, depending on the table size, maps hash values to entry
+   positions.  Probing walks the small index slots and iteration walks the
+   dense entries.
 */
 
 #include "Python.h"
+#include "pycore_bitutils.h"      // _Py_bit_length()
 #include "pycore_critical_section.h"
 #include "pycore_object.h"        // _PyObject_GC_UNTRACK()
 #include <stddef.h>               // offsetof()
 
-/* Object used as dummy key to fill deleted entries */
+/* Object exported as _PySet_Dummy.  It used to fill deleted entries;
+   these now have a NULL key. */
 static PyObject _dummy_struct;
 
 #define dummy (&_dummy_struct)
@@ -53,190 +61,336 @@ static PyObject _dummy_struct;
 /* This must be >= 1 */
 #define PERTURB_SHIFT 5
 
-static setentry *
-set_lookkey(PySetObject *so, PyObject *key, Py_hash_t hash)
+/* Index array slots hold the position of an entry in so->table, or one
+   of these negative values. */
+#define SETIX_EMPTY (-1)
+#define SETIX_DUMMY (-2)        /* The entry was deleted */
+#define SETIX_ERROR (-3)        /* Only returned by set_lookkey() */
+
+/* Number of entries that fit in a table whose index array has size slots */
+#define SET_USABLE(size) (((size) << 1) / 3)
+
+static_assert(sizeof(((PySetObject *)NULL)->smalltable) ==
+              SET_USABLE(PySet_MINSIZE) * sizeof(setentry),
+              "smalltable does not match SET_USABLE(PySet_MINSIZE)");
+static_assert(offsetof(PySetObject, smalltable) ==
+              offsetof(PySetObject, smallindices) + PySet_MINSIZE,
+              "smallindices must immediately precede smalltable");
+
+/* log2 of the width in bytes of the index array slots for a table of
+   mask + 1 slots: the narrowest signed integer that can hold the position
+   of every entry. */
+static inline int
+set_index_shift(size_t mask)
+{
+    if (mask <= 0x7f) {
+        return 0;
+    }
+    if (mask <= 0x7fff) {
+        return 1;
+    }
+#if SIZEOF_VOID_P > 4
+    if (mask <= 0x7fffffff) {
+        return 2;
+    }
+    return 3;
+#else
+    return 2;
+#endif
+}
+
+static inline size_t
+set_index_bytes(size_t mask)
 {
-    setentry *table;
-    setentry *entry;
-    size_t perturb = hash;
-    size_t mask = so->mask;
-    size_t i = (size_t)hash & mask; /* Unsigned for defined overflow behavior */
-    int probes;
-    int cmp;
+    return (mask + 1) << set_index_shift(mask);
+}
 
-    while (1) {
-        entry = &so->table[i];
-        probes = (i + LINEAR_PROBES <= mask) ? LINEAR_PROBES: 0;
-        do {
-            if (entry->hash == 0 && entry->key == NULL)
-                return entry;
-            if (entry->hash == hash) {
-                PyObject *startkey = entry->key;
-                assert(startkey != dummy);
-                if (startkey == key)
-                    return entry;
-                if (PyUnicode_CheckExact(startkey)
-                    && PyUnicode_CheckExact(key)
-                    && _PyUnicode_EQ(startkey, key))
-                    return entry;
-                table = so->table;
-                Py_INCREF(startkey);
-                cmp = PyObject_RichCompareBool(startkey, key, Py_EQ);
-                Py_DECREF(startkey);
-                if (cmp < 0)
-                    return NULL;
-                if (table != so->table || entry->key != startkey)
-                    return set_lookkey(so, key, hash);
-                if (cmp > 0)
-                    return entry;
-                mask = so->mask;
-            }
-            entry++;
-        } while (probes--);
-        perturb >>= PERTURB_SHIFT;
-        i = (i * 5 + 1 + perturb) & mask;
+/* Index array slots that refer to an entry also keep the bits of its hash
+   just above the ones selecting the first probe, in the high bits that the
+   entry position leaves unused.  Most probes for other keys are rejected
+   on those bits without loading the entry. */
+static inline Py_ssize_t
+set_hash_tag(size_t mask, int shift, Py_hash_t hash)
+{
+    if (shift > 2) {
+        return 0;
     }
+    int log2_size = _Py_bit_length((unsigned long)mask);
+    size_t tag_mask = ((size_t)1 << ((8 << shift) - 1 - log2_size)) - 1;
+    return (Py_ssize_t)((((size_t)hash >> log2_size) & tag_mask) << log2_size);
 }
 
-static int set_table_resize(PySetObject *, Py_ssize_t);
+/* The index array is stored immediately before the entries */
+static inline void *
+set_indices(setentry *table, size_t mask)
+{
+    return (char *)table - set_index_bytes(mask);
+}
 
-static int
-set_add_entry(PySetObject *so, PyObject *key, Py_hash_t hash)
+static inline Py_ssize_t
+set_get_index(const void *indices, int shift, size_t i)
+{
+    switch (shift) {
+    case 0:
+        return ((const int8_t *)indices)[i];
+    case 1:
+        return ((const int16_t *)indices)[i];
+    case 2:
+        return ((const int32_t *)indices)[i];
+    default:
+        return (Py_ssize_t)((const int64_t *)indices)[i];
+    }
+}
+
+static inline void
+set_set_index(void *indices, int shift, size_t i, Py_ssize_t ix)
+{
+    switch (shift) {
+    case 0:
+        ((int8_t *)indices)[i] = (int8_t)ix;
+        break;
+    case 1:
+        ((int16_t *)indices)[i] = (int16_t)ix;
+        break;
+    case 2:
+        ((int32_t *)indices)[i] = (int32_t)ix;
+        break;
+    default:
+        ((int64_t *)indices)[i] = (int64_t)ix;
+        break;
+    }
+}
+
+static void
+set_table_free(setentry *table, size_t mask)
+{
+    PyMem_Free(set_indices(table, mask));
+}
+
+/*
+Return the position in so->table of the entry matching key, or SETIX_EMPTY
+if there is none, or SETIX_ERROR if a comparison raised.  If slot is not
+NULL, it receives the index array slot referring to the entry or, if the
+key is absent, the first slot where it could be inserted.
+*/
+static Py_ssize_t
+set_lookkey(PySetObject *so, PyObject *key, Py_hash_t hash, size_t *slot)
 {
     setentry *table;
-    setentry *freeslot;
     setentry *entry;
+    void *indices;
     size_t perturb;
     size_t mask;
     size_t i;                       /* Unsigned for defined overflow behavior */
+    size_t j;
+    size_t freeslot;
+    Py_ssize_t ix;
+    Py_ssize_t tag;
+    int shift;
     int probes;
     int cmp;
 
-    /* Pre-increment is necessary to prevent arbitrary code in the rich
-       comparison from deallocating the key just before the insertion. */
-    Py_INCREF(key);
-
   restart:
-
-    mask = so->mask;
-    i = (size_t)hash & mask;
-    freeslot = NULL;
+    table = so->table;
+    mask = (size_t)so->mask;
+    shift = set_index_shift(mask);
+    indices = set_indices(table, mask);
+    tag = set_hash_tag(mask, shift, hash);
     perturb = hash;
+    i = (size_t)hash & mask;
+    freeslot = (size_t)-1;
 
     while (1) {
-        entry = &so->table[i];
+        j = i;
         probes = (i + LINEAR_PROBES <= mask) ? LINEAR_PROBES: 0;
         do {
-            if (entry->hash == 0 && entry->key == NULL)
-                goto found_unused_or_dummy;
-            if (entry->hash == hash) {
+            ix = set_get_index(indices, shift, j);
+            if (ix == SETIX_EMPTY) {
+                if (slot != NULL)
+                    *slot = freeslot == (size_t)-1 ? j : freeslot;
+                return SETIX_EMPTY;
+            }
+            if (ix == SETIX_DUMMY) {
+                if (freeslot == (size_t)-1)
+                    freeslot = j;
+            }
+            else if ((ix & ~(Py_ssize_t)mask) == tag &&
+                     table[ix & mask].hash == hash) {
+                ix &= mask;
+                entry = &table[ix];
                 PyObject *startkey = entry->key;
-                assert(startkey != dummy);
+                assert(startkey != NULL);
                 if (startkey == key)
-                    goto found_active;
+                    goto found;
                 if (PyUnicode_CheckExact(startkey)
                     && PyUnicode_CheckExact(key)
                     && _PyUnicode_EQ(startkey, key))
-                    goto found_active;
-                table = so->table;
+                    goto found;
                 Py_INCREF(startkey);
                 cmp = PyObject_RichCompareBool(startkey, key, Py_EQ);
                 Py_DECREF(startkey);
-                if (cmp > 0)
-                    goto found_active;
                 if (cmp < 0)
-                    goto comparison_error;
+                    return SETIX_ERROR;
                 if (table != so->table || entry->key != startkey)
                     goto restart;
-                mask = so->mask;
-            }
-            else if (entry->hash == -1) {
-                assert (entry->key == dummy);
-                freeslot = entry;
+                if (cmp > 0)
+                    goto found;
             }
-            entry++;
+            j++;
         } while (probes--);
         perturb >>= PERTURB_SHIFT;
         i = (i * 5 + 1 + perturb) & mask;
     }
 
-  found_unused_or_dummy:
-    if (freeslot == NULL)
-        goto found_unused;
-    so->used++;
-    freeslot->key = key;
-    freeslot->hash = hash;
-    return 0;
-
-  found_unused:
-    so->fill++;
-    _Py_atomic_store_ssize_relaxed(&so->used, so->used + 1);
-    entry->key = key;
-    entry->hash = hash;
-    if ((size_t)so->fill*5 < mask*3)
-        return 0;
-    return set_table_resize(so, so->used>50000 ? so->used*2 : so->used*4);
+  found:
+    if (slot != NULL)
+        *slot = j;
+    return ix;
+}
 
-  found_active:
-    Py_DECREF(key);
-    return 0;
+/* Return the first index array slot in the probe sequence for hash that
+   does not refer to an entry.  There is always at least one. */
+static size_t
+set_find_empty_slot(const void *indices, int shift, size_t mask,
+                    Py_hash_t hash)
+{
+    size_t perturb = hash;
+    size_t i = (size_t)hash & mask;
+    size_t j;
+    int probes;
 
-  comparison_error:
-    Py_DECREF(key);
-    return -1;
+    while (1) {
+        j = i;
+        probes = (i + LINEAR_PROBES <= mask) ? LINEAR_PROBES: 0;
+        do {
+            if (set_get_index(indices, shift, j) < 0)
+                return j;
+            j++;
+        } while (probes--);
+        perturb >>= PERTURB_SHIFT;
+        i = (i * 5 + 1 + perturb) & mask;
+    }
 }
 
-/*
-Internal routine used by set_table_resize() to insert an item which is
-known to be absent from the set.  Besides the performance benefit,
-there is also safety benefit since using set_add_entry() risks making
-a callback in the middle of a set_table_resize(), see issue 1456209.
-The caller is responsible for updating the key's reference count and
-the setobject's fill and used fields.
-*/
-static void
-set_insert_clean(setentry *table, size_t mask, PyObject *key, Py_hash_t hash)
+/* Return the index array slot referring to the entry at position ix */
+static size_t
+set_lookup_slot(PySetObject *so, Py_hash_t hash, Py_ssize_t ix)
 {
-    setentry *entry;
+    size_t mask = (size_t)so->mask;
+    int shift = set_index_shift(mask);
+    void *indices = set_indices(so->table, mask);
     size_t perturb = hash;
     size_t i = (size_t)hash & mask;
     size_t j;
+    int probes;
 
+    ix |= set_hash_tag(mask, shift, hash);
     while (1) {
-        entry = &table[i];
-        if (entry->key == NULL)
-            goto found_null;
-        if (i + LINEAR_PROBES <= mask) {
-            for (j = 0; j < LINEAR_PROBES; j++) {
-                entry++;
-                if (entry->key == NULL)
-                    goto found_null;
-            }
-        }
+        j = i;
+        probes = (i + LINEAR_PROBES <= mask) ? LINEAR_PROBES: 0;
+        do {
+            Py_ssize_t found = set_get_index(indices, shift, j);
+            assert(found != SETIX_EMPTY);
+            if (found == ix)
+                return j;
+            j++;
+        } while (probes--);
         perturb >>= PERTURB_SHIFT;
         i = (i * 5 + 1 + perturb) & mask;
     }
-  found_null:
+}
+
+/* Append an entry to the table and refer to it from the given free slot
+   of the index array.  The table must have room for the entry. */
+static void
+set_append_entry(PySetObject *so, size_t slot, PyObject *key, Py_hash_t hash)
+{
+    size_t mask = (size_t)so->mask;
+    int shift = set_index_shift(mask);
+    setentry *entry = &so->table[so->fill];
+
+    assert(so->fill < SET_USABLE(so->mask + 1));
     entry->key = key;
     entry->hash = hash;
+    set_set_index(set_indices(so->table, mask), shift, slot,
+                  so->fill | set_hash_tag(mask, shift, hash));
+    so->fill++;
+}
+
+/*
+Internal routine used to append an entry for a key which is known to be
+absent from the set.  Besides the performance benefit, there is also
+safety benefit since using set_add_entry() risks making a callback in the
+middle of a merge, see issue 1456209.  The table must have room for the
+entry.  The caller is responsible for updating the key's reference count
+and the setobject's used field.
+*/
+static void
+set_insert_clean(PySetObject *so, PyObject *key, Py_hash_t hash)
+{
+    size_t mask = (size_t)so->mask;
+    size_t slot = set_find_empty_slot(set_indices(so->table, mask),
+                                      set_index_shift(mask), mask, hash);
+    set_append_entry(so, slot, key, hash);
+}
+
+static int set_table_resize(PySetObject *, Py_ssize_t);
+
+static int
+set_add_entry(PySetObject *so, PyObject *key, Py_hash_t hash)
+{
+    Py_ssize_t ix;
+    size_t slot;
+
+    /* Pre-increment is necessary to prevent arbitrary code in the rich
+       comparison from deallocating the key just before the insertion. */
+    Py_INCREF(key);
+
+    ix = set_lookkey(so, key, hash, &slot);
+    if (ix == SETIX_ERROR)
+        goto error;
+    if (ix >= 0) {
+        /* Already present */
+        Py_DECREF(key);
+        return 0;
+    }
+    if (so->fill >= SET_USABLE(so->mask + 1)) {
+        if (set_table_resize(so, so->used>50000 ? so->used*2 : so->used*4))
+            goto error;
+        set_insert_clean(so, key, hash);
+    }
+    else {
+        set_append_entry(so, slot, key, hash);
+    }
+    _Py_atomic_store_ssize_relaxed(&so->used, so->used + 1);
+    return 0;
+
+  error:
+    Py_DECREF(key);
+    return -1;
 }
 
 /* ======== End logic for probing the hash table ========================== */
 /* ======================================================================== */
 
 /*
-Restructure the table by allocating a new table and reinserting all
-keys again.  When entries have been deleted, the new table may
+Restructure the table by allocating a new table and copying the active
+entries over, in order.  When entries have been deleted, the new table may
 actually be smaller than the old one.
 */
 static int
 set_table_resize(PySetObject *so, Py_ssize_t minused)
 {
-    setentry *oldtable, *newtable, *entry;
-    Py_ssize_t oldmask = so->mask;
+    setentry *oldtable, *newtable;
+    size_t oldmask = (size_t)so->mask;
+    Py_ssize_t oldfill = so->fill;
+    Py_ssize_t used = so->used;
     size_t newmask;
+    Py_ssize_t i, j;
     int is_oldtable_malloced;
-    setentry small_copy[PySet_MINSIZE];
+    int shift;
+    void *indices;
+    setentry small_copy[SET_USABLE(PySet_MINSIZE)];
 
     assert(minused >= 0);
 
@@ -246,6 +400,7 @@ set_table_resize(PySetObject *so, Py_ssize_t minused)
     while (newsize <= (size_t)minused) {
         newsize <<= 1; // The largest possible value is PY_SSIZE_T_MAX + 1.
     }
+    assert(SET_USABLE(newsize) >= (size_t)used);
 
     /* Get space for a new table. */
     oldtable = so->table;
@@ -256,67 +411,94 @@ set_table_resize(PySetObject *so, Py_ssize_t minused)
         /* A large table is shrinking, or we can't get any smaller. */
         newtable = so->smalltable;
         if (newtable == oldtable) {
-            if (so->fill == so->used) {
-                /* No dummies, so no point doing anything. */
+            if (oldfill == used) {
+                /* No deleted entries, so no point doing anything. */
                 return 0;
             }
             /* We're not going to resize it, but rebuild the
-               table anyway to purge old dummy entries.
-               Subtle:  This is *necessary* if fill==size,
-               as set_lookkey needs at least one virgin slot to
-               terminate failing searches.  If fill < size, it's
-               merely desirable, as dummies slow searches. */
-            assert(so->fill > so->used);
-            memcpy(small_copy, oldtable, sizeof(small_copy));
+               table anyway to purge deleted entries and make room
+               for new ones. */
+            memcpy(small_copy, oldtable, oldfill * sizeof(setentry));
             oldtable = small_copy;
         }
     }
     else {
-        newtable = PyMem_NEW(setentry, newsize);
-        if (newtable == NULL) {
+        size_t index_bytes = set_index_bytes(newsize - 1);
+        size_t usable = SET_USABLE(newsize);
+        char *block;
+        if (usable > (PY_SSIZE_T_MAX - index_bytes) / sizeof(setentry)) {
             PyErr_NoMemory();
             return -1;
         }
+        block = PyMem_Malloc(index_bytes + usable * sizeof(setentry));
+        if (block == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        newtable = (setentry *)(block + index_bytes);
     }
 
     /* Make the set empty, using the new table. */
     assert(newtable != oldtable);
-    memset(newtable, 0, sizeof(setentry) * newsize);
-    so->mask = newsize - 1;
-    so->table = newtable;
+    newmask = newsize - 1;
+    shift = set_index_shift(newmask);
+    indices = set_indices(newtable, newmask);
+    memset(indices, 0xff, set_index_bytes(newmask));    /* SETIX_EMPTY */
 
     /* Copy the data over; this is refcount-neutral for active entries;
-       dummy entries aren't copied over, of course */
-    newmask = (size_t)so->mask;
-    if (so->fill == so->used) {
-        for (entry = oldtable; entry <= oldtable + oldmask; entry++) {
-            if (entry->key != NULL) {
-                set_insert_clean(newtable, newmask, entry->key, entry->hash);
-            }
-        }
-    } else {
-        so->fill = so->used;
-        for (entry = oldtable; entry <= oldtable + oldmask; entry++) {
-            if (entry->key != NULL && entry->key != dummy) {
-                set_insert_clean(newtable, newmask, entry->key, entry->hash);
+       deleted entries aren't copied over, of course */
+    if (oldfill == used) {
+        memcpy(newtable, oldtable, used * sizeof(setentry));
+    }
+    else {
+        for (i = 0, j = 0; i < oldfill; i++) {
+            if (oldtable[i].key != NULL) {
+                newtable[j++] = oldtable[i];
             }
         }
+        assert(j == used);
+    }
+    for (j = 0; j < used; j++) {
+        Py_hash_t hash = newtable[j].hash;
+        i = set_find_empty_slot(indices, shift, newmask, hash);
+        set_set_index(indices, shift, i,
+                      j | set_hash_tag(newmask, shift, hash));
     }
+    so->mask = newmask;
+    so->table = newtable;
+    so->fill = used;
+    so->finger = 0;
 
     if (is_oldtable_malloced)
-        PyMem_Free(oldtable);
+        set_table_free(oldtable, oldmask);
     return 0;
 }
 
 static int
 set_contains_entry(PySetObject *so, PyObject *key, Py_hash_t hash)
 {
-    setentry *entry;
+    Py_ssize_t ix;
 
-    entry = set_lookkey(so, key, hash);
-    if (entry != NULL)
-        return entry->key != NULL;
-    return -1;
+    ix = set_lookkey(so, key, hash, NULL);
+    if (ix == SETIX_ERROR)
+        return -1;
+    return ix >= 0;
+}
+
+/* Remove the entry at position ix, referred to by the index array slot */
+static PyObject *
+set_delete_entry(PySetObject *so, Py_ssize_t ix, size_t slot)
+{
+    size_t mask = (size_t)so->mask;
+    setentry *entry = &so->table[ix];
+    PyObject *old_key = entry->key;
+
+    set_set_index(set_indices(so->table, mask), set_index_shift(mask), slot,
+                  SETIX_DUMMY);
+    entry->key = NULL;
+    entry->hash = -1;
+    _Py_atomic_store_ssize_relaxed(&so->used, so->used - 1);
+    return old_key;
 }
 
 #define DISCARD_NOTFOUND 0
@@ -325,19 +507,15 @@ set_contains_entry(PySetObject *so, PyObject *key, Py_hash_t hash)
 static int
 set_discard_entry(PySetObject *so, PyObject *key, Py_hash_t hash)
 {
-    setentry *entry;
-    PyObject *old_key;
+    Py_ssize_t ix;
+    size_t slot;
 
-    entry = set_lookkey(so, key, hash);
-    if (entry == NULL)
+    ix = set_lookkey(so, key, hash, &slot);
+    if (ix == SETIX_ERROR)
         return -1;
-    if (entry->key == NULL)
+    if (ix < 0)
         return DISCARD_NOTFOUND;
-    old_key = entry->key;
-    entry->key = dummy;
-    entry->hash = -1;
-    _Py_atomic_store_ssize_relaxed(&so->used, so->used - 1);
-    Py_DECREF(old_key);
+    Py_DECREF(set_delete_entry(so, ix, slot));
     return DISCARD_FOUND;
 }
 
@@ -404,12 +582,16 @@ set_discard_key(PySetObject *so, PyObject *key)
 static void
 set_empty_to_minsize(PySetObject *so)
 {
+    memset(so->smallindices, 0xff, sizeof(so->smallindices));
+    /* Clear the keys too: set_lookkey() relies on them to notice that
+       the set was cleared during a comparison. */
     memset(so->smalltable, 0, sizeof(so->smalltable));
     so->fill = 0;
     _Py_atomic_store_ssize_relaxed(&so->used, 0);
     so->mask = PySet_MINSIZE - 1;
     so->table = so->smalltable;
     so->hash = -1;
+    so->finger = 0;
 }
 
 static int
@@ -417,10 +599,11 @@ set_clear_internal(PySetObject *so)
 {
     setentry *entry;
     setentry *table = so->table;
+    size_t mask = (size_t)so->mask;
     Py_ssize_t fill = so->fill;
     Py_ssize_t used = so->used;
     int table_is_malloced = table != so->smalltable;
-    setentry small_copy[PySet_MINSIZE];
+    setentry small_copy[SET_USABLE(PySet_MINSIZE)];
 
     assert (PyAnySet_Check(so));
     assert(table != NULL);
@@ -439,7 +622,7 @@ set_clear_internal(PySetObject *so)
          * Afraid the only safe way is to copy the set entries into
          * another small table first.
          */
-        memcpy(small_copy, table, sizeof(small_copy));
+        memcpy(small_copy, table, fill * sizeof(setentry));
         table = small_copy;
         set_empty_to_minsize(so);
     }
@@ -450,14 +633,14 @@ set_clear_internal(PySetObject *so)
      * has unique access to it, so decref side-effects can't alter it.
      */
     for (entry = table; used > 0; entry++) {
-        if (entry->key && entry->key != dummy) {
+        if (entry->key) {
             used--;
             Py_DECREF(entry->key);
         }
     }
 
     if (table_is_malloced)
-        PyMem_Free(table);
+        set_table_free(table, mask);
     return 0;
 }
 
@@ -489,20 +672,20 @@ static int
 set_next(PySetObject *so, Py_ssize_t *pos_ptr, setentry **entry_ptr)
 {
     Py_ssize_t i;
-    Py_ssize_t mask;
+    Py_ssize_t fill;
     setentry *entry;
 
     assert (PyAnySet_Check(so));
     i = *pos_ptr;
     assert(i >= 0);
-    mask = so->mask;
+    fill = so->fill;
     entry = &so->table[i];
-    while (i <= mask && (entry->key == NULL || entry->key == dummy)) {
+    while (i < fill && entry->key == NULL) {
         i++;
         entry++;
     }
     *pos_ptr = i+1;
-    if (i > mask)
+    if (i >= fill)
         return 0;
     assert(entry != NULL);
     *entry_ptr = entry;
@@ -522,13 +705,13 @@ set_dealloc(PySetObject *so)
         PyObject_ClearWeakRefs((PyObject *) so);
 
     for (entry = so->table; used > 0; entry++) {
-        if (entry->key && entry->key != dummy) {
+        if (entry->key) {
                 used--;
                 Py_DECREF(entry->key);
         }
     }
     if (so->table != so->smalltable)
-        PyMem_Free(so->table);
+        set_table_free(so->table, (size_t)so->mask);
     Py_TYPE(so)->tp_free(so);
     Py_TRASHCAN_END
 }
@@ -611,7 +794,7 @@ set_merge(PySetObject *so, PyObject *otherset)
      * incrementally resizing as we insert new keys.  Expect
      * that there will be no (or few) overlapping keys.
      */
-    if ((so->fill + other->used)*5 >= so->mask*3) {
+    if (so->fill + other->used > SET_USABLE(so->mask + 1)) {
         if (set_table_resize(so, (so->used + other->used)*2) != 0) {
             ret = -1;
             goto done;
@@ -621,15 +804,15 @@ set_merge(PySetObject *so, PyObject *otherset)
     other_entry = other->table;
 
     /* If our table is empty, and both tables have the same size, and
-       there are no dummies to eliminate, then just copy the pointers. */
+       there are no deleted entries to eliminate, then just copy the
+       index array and the pointers. */
     if (so->fill == 0 && so->mask == other->mask && other->fill == other->used) {
-        for (i = 0; i <= other->mask; i++, so_entry++, other_entry++) {
-            key = other_entry->key;
-            if (key != NULL) {
-                assert(so_entry->key == NULL);
-                so_entry->key = Py_NewRef(key);
-                so_entry->hash = other_entry->hash;
-            }
+        size_t mask = (size_t)so->mask;
+        memcpy(set_indices(so_entry, mask), set_indices(other_entry, mask),
+               set_index_bytes(mask));
+        for (i = 0; i < other->used; i++, so_entry++, other_entry++) {
+            so_entry->key = Py_NewRef(other_entry->key);
+            so_entry->hash = other_entry->hash;
         }
         so->fill = other->fill;
         so->used = other->used;
@@ -638,25 +821,21 @@ set_merge(PySetObject *so, PyObject *otherset)
 
     /* If our table is empty, we can use set_insert_clean() */
     if (so->fill == 0) {
-        setentry *newtable = so->table;
-        size_t newmask = (size_t)so->mask;
-        so->fill = other->used;
-        so->used = other->used;
-        for (i = other->mask + 1; i > 0 ; i--, other_entry++) {
+        for (i = other->fill; i > 0 ; i--, other_entry++) {
             key = other_entry->key;
-            if (key != NULL && key != dummy) {
-                set_insert_clean(newtable, newmask, Py_NewRef(key),
-                                 other_entry->hash);
+            if (key != NULL) {
+                set_insert_clean(so, Py_NewRef(key), other_entry->hash);
             }
         }
+        so->used = other->used;
         goto done;
     }
 
     /* We can't assure there are no duplicates, so do normal insertions */
-    for (i = 0; i <= other->mask; i++) {
+    for (i = 0; i < other->fill; i++) {
         other_entry = &other->table[i];
         key = other_entry->key;
-        if (key != NULL && key != dummy) {
+        if (key != NULL) {
             if (set_add_entry(so, key, other_entry->hash)) {
                 ret = -1;
                 goto done;
@@ -690,7 +869,7 @@ set_merge_dict(PySetObject *so, PyObject *other)
         ret = -1;
         goto exit;
     }
-    if ((so->fill + dictsize)*5 >= so->mask*3) {
+    if (so->fill + dictsize > SET_USABLE(so->mask + 1)) {
         if (set_table_resize(so, (so->used + dictsize)*2) != 0) {
             ret = -1;
             goto exit;
@@ -713,23 +892,19 @@ set_pop(PySetObject *so, PyObject *Py_UNUSED(ignored))
     PyObject *key = NULL;
 
     Py_BEGIN_CRITICAL_SECTION(so);
-    /* Make sure the search finger is in bounds */
-    setentry *entry = so->table + (so->finger & so->mask);
-    setentry *limit = so->table + so->mask;
+    /* All the entries before the search finger have been deleted */
+    Py_ssize_t ix = so->finger;
     if (so->used == 0) {
         PyErr_SetString(PyExc_KeyError, "pop from an empty set");
         goto exit;
     }
-    while (entry->key == NULL || entry->key==dummy) {
-        entry++;
-        if (entry > limit)
-            entry = so->table;
+    assert(ix < so->fill);
+    while (so->table[ix].key == NULL) {
+        ix++;
+        assert(ix < so->fill);
     }
-    key = entry->key;
-    entry->key = dummy;
-    entry->hash = -1;
-    _Py_atomic_store_ssize_relaxed(&so->used, so->used - 1);
-    so->finger = entry - so->table + 1;   /* next place to start */
+    key = set_delete_entry(so, ix, set_lookup_slot(so, so->table[ix].hash, ix));
+    so->finger = ix + 1;   /* next place to start */
 
 exit:
     Py_END_CRITICAL_SECTION;
@@ -780,21 +955,16 @@ frozenset_hash(PyObject *self)
     /* Xor-in shuffled bits from every entry's hash field because xor is
        commutative and a frozenset hash should be independent of order.
 
-       For speed, include null entries and dummy entries and then
-       subtract out their effect afterwards so that the final hash
-       depends only on active entries.  This allows the code to be
-       vectorized by the compiler and it saves the unpredictable
-       branches that would arise when trying to exclude null and dummy
-       entries on every iteration. */
+       For speed, include deleted entries and then subtract out their
+       effect afterwards so that the final hash depends only on active
+       entries.  This allows the code to be vectorized by the compiler
+       and it saves the unpredictable branches that would arise when
+       trying to exclude deleted entries on every iteration. */
 
-    for (entry = so->table; entry <= &so->table[so->mask]; entry++)
+    for (entry = so->table; entry < &so->table[so->fill]; entry++)
         hash ^= _shuffle_bits(entry->hash);
 
-    /* Remove the effect of an odd number of NULL entries */
-    if ((so->mask + 1 - so->fill) & 1)
-        hash ^= _shuffle_bits(0);
-
-    /* Remove the effect of an odd number of dummy entries */
+    /* Remove the effect of an odd number of deleted entries */
     if ((so->fill - so->used) & 1)
         hash ^= _shuffle_bits(-1);
 
@@ -879,7 +1049,7 @@ static PyMethodDef setiter_methods[] = {
 static PyObject *setiter_iternext(setiterobject *si)
 {
     PyObject *key = NULL;
-    Py_ssize_t i, mask;
+    Py_ssize_t i, fill;
     setentry *entry;
     PySetObject *so = si->si_set;
 
@@ -898,11 +1068,11 @@ static PyObject *setiter_iternext(setiterobject *si)
     i = si->si_pos;
     assert(i>=0);
     entry = so->table;
-    mask = so->mask;
-    while (i <= mask && (entry[i].key == NULL || entry[i].key == dummy))
+    fill = so->fill;
+    while (i < fill && entry[i].key == NULL)
         i++;
     si->si_pos = i+1;
-    if (i > mask) {
+    if (i >= fill) {
         goto exit;
     }
     si->len--;
@@ -1032,6 +1202,7 @@ make_new_set(PyTypeObject *type, PyObject *iterable)
     so->hash = -1;
     so->finger = 0;
     so->weakreflist = NULL;
+    memset(so->smallindices, 0xff, sizeof(so->smallindices));
 
     if (iterable != NULL) {
         if (set_update_internal(so, iterable)) {
@@ -1126,12 +1297,14 @@ set_swap_bodies(PySetObject *a, PySetObject *b)
 {
     Py_ssize_t t;
     setentry *u;
-    setentry tab[PySet_MINSIZE];
+    setentry tab[SET_USABLE(PySet_MINSIZE)];
+    int8_t ix[PySet_MINSIZE];
     Py_hash_t h;
 
     t = a->fill;     a->fill   = b->fill;        b->fill  = t;
     t = a->used;     a->used   = b->used;        b->used  = t;
     t = a->mask;     a->mask   = b->mask;        b->mask  = t;
+    t = a->finger;   a->finger = b->finger;      b->finger = t;
 
     u = a->table;
     if (a->table == a->smalltable)
@@ -1145,6 +1318,9 @@ set_swap_bodies(PySetObject *a, PySetObject *b)
         memcpy(tab, a->smalltable, sizeof(tab));
         memcpy(a->smalltable, b->smalltable, sizeof(tab));
         memcpy(b->smalltable, tab, sizeof(tab));
+        memcpy(ix, a->smallindices, sizeof(ix));
+        memcpy(a->smallindices, b->smallindices, sizeof(ix));
+        memcpy(b->smallindices, ix, sizeof(ix));
     }
 
     if (PyType_IsSubtype(Py_TYPE(a), &PyFrozenSet_Type)  &&
@@ -1499,7 +1675,7 @@ PyDoc_STRVAR(isdisjoint_doc,
 static int
 set_maybe_resize_dummies(PySetObject *so)
 {
-    /* If more than 1/4th are dummies, then resize them away. */
+    /* If more than 1/4th are deleted entries, then resize them away. */
     if ((size_t)(so->fill - so->used) <= (size_t)so->mask / 4)
         return 0;
     return set_table_resize(so, so->used>50000 ? so->used*2 : so->used*4);
@@ -2148,7 +2324,8 @@ set_sizeof(PySetObject *so, PyObject *Py_UNUSED(ignored))
     Py_BEGIN_CRITICAL_SECTION(so);
     res = _PyObject_SIZE(Py_TYPE(so));
     if (so->table != so->smalltable)
-        res = res + (so->mask + 1) * sizeof(setentry);
+        res = res + set_index_bytes((size_t)so->mask)
+                  + SET_USABLE(so->mask + 1) * sizeof(setentry);
     Py_END_CRITICAL_SECTION;
     return PyLong_FromSize_t(res);
 }
@@ -172,6 +172,10 @@ initialize_token(Parser *p, Token *parser_token, struct token *new_token, int to
     return (token_type == ERRORTOKEN ? _Pypegen_tokenizer_error(p) : 0);
 }
 
+// The tokens are allocated in blocks: every resize doubles the size of
+// the array and allocates all the new tokens at once. Tokens never move,
+// so pointers to them stay valid. A block starts at index 0 and at each
+// power of two, which is what _PyPegen_Parser_Free() relies on.
 static int
 _resize_tokens_array(Parser *p) {
     int newsize = p->size * 2;
@@ -182,13 +186,13 @@ _resize_tokens_array(Parser *p) {
     }
     p->tokens = new_tokens;
 
+    Token *block = PyMem_Calloc(newsize - p->size, sizeof(Token));
+    if (block == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
     for (int i = p->size; i < newsize; i++) {
-        p->tokens[i] = PyMem_Calloc(1, sizeof(Token));
-        if (p->tokens[i] == NULL) {
-            p->size = i; // Needed, in order to cleanup correctly after parser fails
-            PyErr_NoMemory();
-            return -1;
-        }
+        p->tokens[i] = &block[i - p->size];
     }
     p->size = newsize;
     return 0;
@@ -795,7 +799,8 @@ void
 _PyPegen_Parser_Free(Parser *p)
 {
     Py_XDECREF(p->normalize);
-    for (int i = 0; i < p->size; i++) {
+    // See _resize_tokens_array()
+    for (int i = 0; i < p->size; i = i ? i * 2 : 1) {
         PyMem_Free(p->tokens[i]);
     }
     PyMem_Free(p->tokens);
@@ -26,18 +26,20 @@
 
 #define CURRENT_POS (-5)
 
+/* The fields are ordered to avoid padding: the parser allocates one Memo
+   per memoized rule result and one Token per token of the input. */
 typedef struct _memo {
-    int type;
     void *node;
-    int mark;
     struct _memo *next;
+    int type;
+    int mark;
 } Memo;
 
 typedef struct {
     int type;
-    PyObject *bytes;
     int level;
     int lineno, col_offset, end_lineno, end_col_offset;
+    PyObject *bytes;
     Memo *memo;
 } Token;
 
@@ -1122,6 +1122,69 @@ tok_backup(struct tok_state *tok, int c)
     }
 }
 
+/* The tok_skip_*() functions advance over a run of characters that need
+   no further processing, reading directly from the buffered line instead
+   of calling tok_nextc() for each character.  They never move past the
+   end of the buffer, so the next tok_nextc() call still sees the first
+   character that needs processing or refills the buffer as usual. */
+
+static inline void
+tok_skip_to(struct tok_state *tok, const char *p)
+{
+    tok->col_offset += (int)(p - tok->cur);
+    tok->cur = (char *)p;
+}
+
+/* Skip ASCII letters, digits and underscores. */
+static void
+tok_skip_ascii_identifier(struct tok_state *tok)
+{
+    const char *p = tok->cur;
+    while (p < tok->inp && (Py_ISALNUM(*p) || *p == '_')) {
+        p++;
+    }
+    tok_skip_to(tok, p);
+}
+
+/* Skip everything up to the end of the line. */
+static void
+tok_skip_comment(struct tok_state *tok)
+{
+    const char *p = memchr(tok->cur, '\n', tok->inp - tok->cur);
+    tok_skip_to(tok, p != NULL ? p : tok->inp);
+}
+
+#if SIZEOF_SIZE_T == 8
+# define SWAR_ONES 0x0101010101010101ULL
+#else
+# define SWAR_ONES 0x01010101U
+#endif
+/* Non-zero if any byte of the word v is zero. */
+#define SWAR_HAS_ZERO(v) (((v) - SWAR_ONES) & ~(v) & (SWAR_ONES * 0x80))
+/* Non-zero if any byte of the word v is equal to c. */
+#define SWAR_HAS_BYTE(v, c) SWAR_HAS_ZERO((v) ^ (SWAR_ONES * (unsigned char)(c)))
+
+/* Skip the body of a string literal up to the next quote, backslash or
+   newline.  The bulk of the body is checked a word at a time. */
+static void
+tok_skip_string_body(struct tok_state *tok, int quote)
+{
+    const char *p = tok->cur;
+    while (tok->inp - p >= SIZEOF_SIZE_T) {
+        size_t value;
+        memcpy(&value, p, SIZEOF_SIZE_T);
+        if (SWAR_HAS_BYTE(value, quote) || SWAR_HAS_BYTE(value, '\\') ||
+            SWAR_HAS_BYTE(value, '\n')) {
+            break;
+        }
+        p += SIZEOF_SIZE_T;
+    }
+    while (p < tok->inp && *p != quote && *p != '\\' && *p != '\n') {
+        p++;
+    }
+    tok_skip_to(tok, p);
+}
+
 static int
 _syntaxerror_range(struct tok_state *tok, const char *format,
                    int col_offset, int end_col_offset,
@@ -1606,6 +1669,7 @@ tok_get(struct tok_state *tok, struct token *token)
         int current_starting_col_offset;
 
         while (c != EOF && c != '\n') {
+            tok_skip_comment(tok);
             c = tok_nextc(tok);
         }
 
@@ -1710,6 +1774,7 @@ tok_get(struct tok_state *tok, struct token *token)
             if (c >= 128) {
                 nonascii = 1;
             }
+            tok_skip_ascii_identifier(tok);
             c = tok_nextc(tok);
         }
         tok_backup(tok, c);
@@ -2034,6 +2099,9 @@ tok_get(struct tok_state *tok, struct token *token)
 
         /* Get rest of string */
         while (end_quote_size != quote_size) {
+            if (end_quote_size == 0) {
+                tok_skip_string_body(tok, quote);
+            }
             c = tok_nextc(tok);
             if (tok->done == E_DECODE)
                 break;
@@ -2346,21 +2346,26 @@ sorted as builtin_sorted
     iterable as seq: object
     key as keyfunc: object = None
     reverse: object = False
+    parallel: object = False
 
 Return a new list containing all items from the iterable in ascending order.
 
 A custom key function can be supplied to customize the sort order, and the
-reverse flag can be set to request the result in descending order.
+reverse flag can be set to request the result in descending order.  The
+parallel flag lets a large list be sorted by several threads, as with
+list.sort().
 [end disabled clinic input]*/
 
 PyDoc_STRVAR(builtin_sorted__doc__,
-"sorted($module, iterable, /, *, key=None, reverse=False)\n"
+"sorted($module, iterable, /, *, key=None, reverse=False, parallel=False)\n"
 "--\n"
 "\n"
 "Return a new list containing all items from the iterable in ascending order.\n"
 "\n"
 "A custom key function can be supplied to customize the sort order, and the\n"
-"reverse flag can be set to request the result in descending order.");
+"reverse flag can be set to request the result in descending order.  The\n"
+"parallel flag lets a large list be sorted by several threads, as with\n"
+"list.sort().");
 
 #define BUILTIN_SORTED_METHODDEF    \
     {"sorted", _PyCFunction_CAST(builtin_sorted), METH_FASTCALL | METH_KEYWORDS, builtin_sorted__doc__},
@@ -131,6 +131,15 @@ dummy_func(
             }
         }
 
+        inst(RESUME_QUICKEN, (--)) {
+            /* First execution of this code object: quicken it now rather
+             * than when it was created, since most code that is loaded is
+             * never run. This also turns the instruction back into RESUME. */
+            _PyCode_QuickenOnce(frame->f_code);
+            assert(_Py_OPCODE(next_instr[-1]) == RESUME);
+            GO_TO_INSTRUCTION(RESUME);
+        }
+
         inst(LOAD_CLOSURE, (-- value)) {
             /* We keep LOAD_CLOSURE so that the bytecode stays more readable. */
             value = GETLOCAL(oparg);
@@ -3209,10 +3218,34 @@ dummy_func(
                 kwargs = POP();
                 // DICT_MERGE is called before this opcode if there are kwargs.
                 // It converts all dict subtypes in kwargs into regular dicts.
-                assert(PyDict_CheckExact(kwargs));
+                assert((oparg & 0x02) || PyDict_CheckExact(kwargs));
             }
             callargs = POP();
             func = TOP();
+            if (oparg & 0x02) {
+                // The compiler skipped the BUILD_MAP/DICT_MERGE copy because
+                // kwargs is the caller's own **kwargs parameter. Vectorcall
+                // callees only read the dict while unpacking it, so it can be
+                // forwarded as is. Anything else gets its own copy, since a
+                // tp_call callee may mutate the dict it receives.
+                if (!PyDict_CheckExact(kwargs) ||
+                    _PyVectorcall_Function(func) == NULL)
+                {
+                    PyObject *copy = PyDict_New();
+                    if (copy == NULL ||
+                        _PyDict_MergeEx(copy, kwargs, 2) < 0)
+                    {
+                        if (copy != NULL) {
+                            format_kwargs_error(tstate, func, kwargs);
+                            Py_DECREF(copy);
+                        }
+                        Py_DECREF(callargs);
+                        Py_DECREF(kwargs);
+                        goto error;
+                    }
+                    Py_SETREF(kwargs, copy);
+                }
+            }
             if (!PyTuple_CheckExact(callargs)) {
                 if (check_args_iterable(tstate, func, callargs) < 0) {
                     Py_DECREF(callargs);
@@ -3463,6 +3496,7 @@ family(load_attr) = {
 family(load_global) = {
     LOAD_GLOBAL, LODA_GLOBAL_GENERIC, LOAD_GLOBAL_BUILTIN,
     LOAD_GLOBAL_MODULE };
+family(resume) = { RESUME, RESUME_QUICKEN };
 family(store_fast) = { STORE_FAST, STORE_FAST__LOAD_FAST, STORE_FAST__STORE_FAST };
 family(unpack_sequence) = {
     UNPACK_SEQUENCE, UNPACK_SEQUENCE_GENERIC, UNPACK_SEQUENCE_LIST,
@@ -1246,8 +1246,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             int instr_prev = _PyInterpreterFrame_LASTI(frame);
             frame->prev_instr = next_instr;
             NEXTOPARG();
-            // No _PyOpcode_Deopt here, since RESUME has no optimized forms:
-            if (opcode == RESUME) {
+            if (_PyOpcode_Deopt[opcode] == RESUME) {
                 if (oparg < 2) {
                     CHECK_EVAL_BREAKER();
                 }
@@ -1423,6 +1422,9 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
         /* Log traceback info. */
         assert(frame != &entry_frame);
         if (!_PyFrame_IsIncomplete(frame)) {
+            if (frame->frame_obj == NULL) {
+                CALL_STAT_INC(frame_objects_for_traceback);
+            }
             PyFrameObject *f = _PyFrame_GetFrameObject(frame);
             if (f != NULL) {
                 PyTraceBack_Here(f);
@@ -3370,11 +3372,18 @@ format_kwargs_error(PyThreadState *tstate, PyObject *func, PyObject *kwargs)
     else if (_PyErr_ExceptionMatches(tstate, PyExc_KeyError)) {
         PyObject *exc, *val, *tb;
         _PyErr_Fetch(tstate, &exc, &val, &tb);
+        /* _PyErr_SetKeyError() stores str and int keys unwrapped. */
+        PyObject *key = NULL;
         if (val && PyTuple_Check(val) && PyTuple_GET_SIZE(val) == 1) {
+            key = PyTuple_GET_ITEM(val, 0);
+        }
+        else if (val && (PyUnicode_CheckExact(val) || PyLong_CheckExact(val))) {
+            key = val;
+        }
+        if (key != NULL) {
             _PyErr_Clear(tstate);
             PyObject *funcstr = _PyObject_FunctionStr(func);
             if (funcstr != NULL) {
-                PyObject *key = PyTuple_GET_ITEM(val, 0);
                 _PyErr_Format(
                     tstate, PyExc_TypeError,
                     "%U got multiple values for keyword argument '%S'",
@@ -129,6 +129,18 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_imp_module_set_lazy__doc__,
+"module_set_lazy($module, mod, /)\n"
+"--\n"
+"\n"
+"Make the module execute on the first access to one of its attributes.\n"
+"\n"
+"The loader of the module spec is used to execute the module.  Return the\n"
+"copy of the module dict that attributes set before then are compared with.");
+
+#define _IMP_MODULE_SET_LAZY_METHODDEF    \
+    {"module_set_lazy", (PyCFunction)_imp_module_set_lazy, METH_O, _imp_module_set_lazy__doc__},
+
 PyDoc_STRVAR(_imp__fix_co_filename__doc__,
 "_fix_co_filename($module, code, path, /)\n"
 "--\n"
@@ -675,4 +687,4 @@ exit:
 #ifndef _IMP_EXEC_DYNAMIC_METHODDEF
     #define _IMP_EXEC_DYNAMIC_METHODDEF
 #endif /* !defined(_IMP_EXEC_DYNAMIC_METHODDEF) */
-/*[clinic end generated code: output=b6a46c0bc78f054a input=a9049054013a1b77]*/
+/*[clinic end generated code: output=b26b407ee0afa092 input=a9049054013a1b77]*/
@@ -1118,6 +1118,32 @@ sys__clear_type_cache(PyObject *module, PyObject *Py_UNUSED(ignored))
     return sys__clear_type_cache_impl(module);
 }
 
+PyDoc_STRVAR(sys__dict_layout_stats__doc__,
+"_dict_layout_stats($module, /)\n"
+"--\n"
+"\n"
+"Return a dict of counters on how instance dicts share the keys of their class.\n"
+"\n"
+"\"unshared\" counts the instance dicts that were converted from shared keys\n"
+"to a table of their own, \"unshared_keys_full\" and\n"
+"\"unshared_incompatible_key\" those of them converted because the shared\n"
+"keys had no room left for a new attribute or because a key was not an\n"
+"interned str.  \"materialized\" counts the dicts created from the inline\n"
+"attribute values of instances, and \"prepopulated_keys\" the attribute names\n"
+"added to the shared keys of classes before their first instance was created.");
+
+#define SYS__DICT_LAYOUT_STATS_METHODDEF    \
+    {"_dict_layout_stats", (PyCFunction)sys__dict_layout_stats, METH_NOARGS, sys__dict_layout_stats__doc__},
+
+static PyObject *
+sys__dict_layout_stats_impl(PyObject *module);
+
+static PyObject *
+sys__dict_layout_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__dict_layout_stats_impl(module);
+}
+
 PyDoc_STRVAR(sys_is_finalizing__doc__,
 "is_finalizing($module, /)\n"
 "--\n"
@@ -1364,4 +1390,4 @@ sys_is_stack_trampoline_active(PyObject *module, PyObject *Py_UNUSED(ignored))
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=42dcbfb142888cb7 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=8116eff8955f5806 input=a9049054013a1b77]*/
@@ -39,7 +39,9 @@
 #include "opcode_metadata.h"      // _PyOpcode_opcode_metadata
 
 
-#define DEFAULT_BLOCK_SIZE 16
+#define DEFAULT_BLOCK_SIZE 4
+#define CFG_ARENA_MIN_CHUNK_SIZE (4 * 1024)
+#define CFG_ARENA_MAX_CHUNK_SIZE (256 * 1024)
 #define DEFAULT_CODE_SIZE 128
 #define DEFAULT_LNOTAB_SIZE 16
 #define DEFAULT_CNOTAB_SIZE 32
@@ -304,11 +306,31 @@ write_instr(_Py_CODEUNIT *codestr, struct instr *instruction, int ilen)
     }
 }
 
+/* Basic blocks and their instruction arrays are bump-allocated from chunks
+   owned by the cfg_builder, and are all released together when it is
+   finalized.  An instruction array that outgrows its space is copied to a
+   bigger one; the old one is only reclaimed with the rest of its chunk. */
+typedef struct cfg_chunk_ {
+    struct cfg_chunk_ *c_prev;
+    char *c_end;
+} cfg_chunk;
+
+typedef struct {
+    /* The chunk being allocated from, linked to the previous ones */
+    cfg_chunk *a_chunk;
+    /* First free byte in a_chunk */
+    char *a_next;
+    /* Size of the next chunk to allocate */
+    size_t a_chunk_size;
+} cfg_arena;
+
 typedef struct basicblock_ {
     /* Each basicblock in a compilation unit is linked via b_list in the
        reverse order that the block are allocated.  b_list points to the next
        block, not to be confused with b_next, which is next by control flow. */
     struct basicblock_ *b_list;
+    /* The arena that b_instr is allocated from */
+    cfg_arena *b_arena;
     /* The label of this block if it is a jump target, -1 otherwise */
     int b_label;
     /* Exception stack at start of block, used by assembler to create the exception handling table */
@@ -418,6 +440,10 @@ typedef struct cfg_builder_ {
     jump_target_label g_current_label;
     /* next free label id */
     int g_next_free_label;
+    /* memory for the blocks, and for their instructions.  They are kept
+       apart so that passes over the blocks alone touch less memory. */
+    cfg_arena g_block_arena;
+    cfg_arena g_instr_arena;
 } cfg_builder;
 
 /* The following items change on entry and exit of code blocks.
@@ -827,10 +853,57 @@ cfg_builder_check(cfg_builder *g)
     }
 }
 
+static void *
+cfg_arena_alloc(cfg_arena *a, size_t size)
+{
+    size = _Py_SIZE_ROUND_UP(size, sizeof(void *));
+    if (a->a_chunk == NULL || (size_t)(a->a_chunk->c_end - a->a_next) < size) {
+        size_t chunk_size = Py_MAX(a->a_chunk_size, sizeof(cfg_chunk) + size);
+        cfg_chunk *chunk = (cfg_chunk *)PyMem_Malloc(chunk_size);
+        if (chunk == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        chunk->c_prev = a->a_chunk;
+        chunk->c_end = (char *)chunk + chunk_size;
+        a->a_chunk = chunk;
+        a->a_next = (char *)(chunk + 1);
+        if (a->a_chunk_size < CFG_ARENA_MAX_CHUNK_SIZE) {
+            a->a_chunk_size *= 2;
+        }
+    }
+    void *result = a->a_next;
+    a->a_next += size;
+    return result;
+}
+
+static void
+cfg_arena_init(cfg_arena *a)
+{
+    a->a_chunk = NULL;
+    a->a_next = NULL;
+    a->a_chunk_size = CFG_ARENA_MIN_CHUNK_SIZE;
+}
+
+static void
+cfg_arena_free(cfg_arena *a)
+{
+    cfg_chunk *chunk = a->a_chunk;
+    while (chunk != NULL) {
+        cfg_chunk *prev = chunk->c_prev;
+        PyMem_Free(chunk);
+        chunk = prev;
+    }
+    a->a_chunk = NULL;
+    a->a_next = NULL;
+}
+
 static int
 cfg_builder_init(cfg_builder *g)
 {
     g->g_block_list = NULL;
+    cfg_arena_init(&g->g_block_arena);
+    cfg_arena_init(&g->g_instr_arena);
     basicblock *block = cfg_builder_new_block(g);
     if (block == NULL) {
         return ERROR;
@@ -844,15 +917,9 @@ static void
 cfg_builder_fini(cfg_builder* g)
 {
     cfg_builder_check(g);
-    basicblock *b = g->g_block_list;
-    while (b != NULL) {
-        if (b->b_instr) {
-            PyObject_Free((void *)b->b_instr);
-        }
-        basicblock *next = b->b_list;
-        PyObject_Free((void *)b);
-        b = next;
-    }
+    cfg_arena_free(&g->g_block_arena);
+    cfg_arena_free(&g->g_instr_arena);
+    g->g_block_list = NULL;
 }
 
 static void
@@ -957,11 +1024,13 @@ cfg_new_label(cfg_builder *g)
 static basicblock *
 cfg_builder_new_block(cfg_builder *g)
 {
-    basicblock *b = (basicblock *)PyObject_Calloc(1, sizeof(basicblock));
+    basicblock *b = (basicblock *)cfg_arena_alloc(&g->g_block_arena,
+                                                  sizeof(basicblock));
     if (b == NULL) {
-        PyErr_NoMemory();
         return NULL;
     }
+    memset(b, 0, sizeof(basicblock));
+    b->b_arena = &g->g_instr_arena;
     /* Extend the singly linked list of blocks with new block. */
     b->b_list = g->g_block_list;
     g->g_block_list = b;
@@ -1025,37 +1094,40 @@ basicblock_next_instr(basicblock *b)
 {
     assert(b != NULL);
     if (b->b_instr == NULL) {
-        b->b_instr = (struct instr *)PyObject_Calloc(
-                         DEFAULT_BLOCK_SIZE, sizeof(struct instr));
+        b->b_instr = (struct instr *)cfg_arena_alloc(
+                         b->b_arena, DEFAULT_BLOCK_SIZE * sizeof(struct instr));
         if (b->b_instr == NULL) {
-            PyErr_NoMemory();
             return -1;
         }
+        memset(b->b_instr, 0, DEFAULT_BLOCK_SIZE * sizeof(struct instr));
         b->b_ialloc = DEFAULT_BLOCK_SIZE;
     }
     else if (b->b_iused == b->b_ialloc) {
-        struct instr *tmp;
+        cfg_arena *a = b->b_arena;
         size_t oldsize, newsize;
         oldsize = b->b_ialloc * sizeof(struct instr);
         newsize = oldsize << 1;
 
-        if (oldsize > (SIZE_MAX >> 1)) {
+        if (oldsize > (SIZE_MAX >> 1) || b->b_ialloc > (INT_MAX >> 1)) {
             PyErr_NoMemory();
             return -1;
         }
 
-        if (newsize == 0) {
-            PyErr_NoMemory();
-            return -1;
+        if ((char *)b->b_instr + oldsize == a->a_next &&
+            (size_t)(a->a_chunk->c_end - a->a_next) >= newsize - oldsize)
+        {
+            /* The array is the last thing allocated: extend it in place. */
+            a->a_next += newsize - oldsize;
         }
-        b->b_ialloc <<= 1;
-        tmp = (struct instr *)PyObject_Realloc(
-                                        (void *)b->b_instr, newsize);
-        if (tmp == NULL) {
-            PyErr_NoMemory();
-            return -1;
+        else {
+            struct instr *tmp = (struct instr *)cfg_arena_alloc(a, newsize);
+            if (tmp == NULL) {
+                return -1;
+            }
+            memcpy(tmp, b->b_instr, oldsize);
+            b->b_instr = tmp;
         }
-        b->b_instr = tmp;
+        b->b_ialloc <<= 1;
         memset((char *)b->b_instr + oldsize, 0, newsize - oldsize);
     }
     return b->b_iused++;
@@ -5031,6 +5103,36 @@ compiler_call_simple_kw_helper(struct compiler *c, location loc,
 }
 
 
+/* Return 1 if e loads the current function's own **kwargs parameter and
+ * that parameter is never rebound, 0 otherwise.  Such a dict is always a
+ * fresh, exact dict, so CALL_FUNCTION_EX can forward it without first
+ * copying it through BUILD_MAP/DICT_MERGE.
+ */
+static int
+is_forwarded_varkeywords(struct compiler *c, expr_ty e)
+{
+    PySTEntryObject *ste = c->u->u_ste;
+    if (e->kind != Name_kind || ste->ste_type != FunctionBlock ||
+        !ste->ste_varkeywords) {
+        return 0;
+    }
+    Py_ssize_t n = PyList_GET_SIZE(ste->ste_varnames);
+    assert(n > 0);
+    PyObject *kwarg = PyList_GET_ITEM(ste->ste_varnames, n - 1);
+    PyObject *mangled = _Py_Mangle(c->u->u_private, e->v.Name.id);
+    if (mangled == NULL) {
+        return ERROR;
+    }
+    int res = PyUnicode_Compare(mangled, kwarg);
+    Py_DECREF(mangled);
+    if (res != 0) {
+        return PyErr_Occurred() ? ERROR : 0;
+    }
+    long flags = _PyST_GetSymbol(ste, kwarg);
+    return (_PyST_GetScope(ste, kwarg) == LOCAL &&
+            (flags & DEF_BOUND) == DEF_PARAM);
+}
+
 /* shared code between compiler_call and compiler_class */
 static int
 compiler_call_helper(struct compiler *c, location loc,
@@ -5086,6 +5188,16 @@ compiler_call_helper(struct compiler *c, location loc,
         return ERROR;
     }
     /* Then keyword arguments */
+    if (nkwelts == 1 && asdl_seq_GET(keywords, 0)->arg == NULL) {
+        expr_ty value = asdl_seq_GET(keywords, 0)->value;
+        int forward = is_forwarded_varkeywords(c, value);
+        RETURN_IF_ERROR(forward);
+        if (forward) {
+            VISIT(c, expr, value);
+            ADDOP_I(c, loc, CALL_FUNCTION_EX, 0x03);
+            return SUCCESS;
+        }
+    }
     if (nkwelts) {
         /* Has a new dict been pushed */
         int have_dict = 0;
@@ -9590,6 +9702,14 @@ eliminate_empty_basic_blocks(cfg_builder *g) {
                 while (target->b_iused == 0) {
                     target = target->b_next;
                 }
+                /* Point the skipped blocks straight at the target, so that
+                   other jumps into the same run of empty blocks do not
+                   walk it again. */
+                for (basicblock *e = instr->i_target; e != target;) {
+                    basicblock *next = e->b_next;
+                    e->b_next = target;
+                    e = next;
+                }
                 instr->i_target = target;
                 assert(instr->i_target && instr->i_target->b_iused > 0);
             }
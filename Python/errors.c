@@ -189,11 +189,20 @@ PyErr_SetObject(PyObject *exception, PyObject *value)
 
 /* Set a key error with the specified argument, wrapping it in a
  * tuple automatically so that tuple keys are not unpacked as the
- * exception arguments. */
+ * exception arguments.
+ *
+ * Most KeyErrors are swallowed by a caller that only checks
+ * PyErr_ExceptionMatches(), so for the common exact str and int keys the
+ * key itself is stored as the unnormalized value and neither the argument
+ * tuple nor the exception instance is built unless someone looks at it. */
 void
 _PyErr_SetKeyError(PyObject *arg)
 {
     PyThreadState *tstate = _PyThreadState_GET();
+    if (PyUnicode_CheckExact(arg) || PyLong_CheckExact(arg)) {
+        _PyErr_SetObject(tstate, PyExc_KeyError, arg);
+        return;
+    }
     PyObject *tup = PyTuple_Pack(1, arg);
     if (!tup) {
         /* caller will expect error to be set anyway */
@@ -253,6 +262,11 @@ PyErr_GivenExceptionMatches(PyObject *err, PyObject *exc)
         /* maybe caused by "import exceptions" that failed early on */
         return 0;
     }
+    if (err == exc) {
+        /* Common case: an unnormalized exception matched against its
+           own class, e.g. PyErr_ExceptionMatches(PyExc_KeyError). */
+        return 1;
+    }
     if (PyTuple_Check(exc)) {
         Py_ssize_t i, n;
         n = PyTuple_Size(exc);
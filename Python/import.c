@@ -5,6 +5,7 @@
 #include "pycore_import.h"        // _PyImport_BootstrapImp()
 #include "pycore_initconfig.h"    // _PyStatus_OK()
 #include "pycore_interp.h"        // _PyInterpreterState_ClearModules()
+#include "pycore_moduleobject.h"  // _PyModule_SetLazy()
 #include "pycore_namespace.h"     // _PyNamespace_Type
 #include "pycore_pyerrors.h"      // _PyErr_SetString()
 #include "pycore_pyhash.h"        // _Py_KeyedHash()
@@ -259,6 +260,31 @@ _imp_module_initialized_impl(PyObject *module, PyObject *mod,
     Py_RETURN_NONE;
 }
 
+/*[clinic input]
+_imp.module_set_lazy
+
+    mod: object
+    /
+
+Make the module execute on the first access to one of its attributes.
+
+The loader of the module spec is used to execute the module.  Return the
+copy of the module dict that attributes set before then are compared with.
+[clinic start generated code]*/
+
+static PyObject *
+_imp_module_set_lazy(PyObject *module, PyObject *mod)
+/*[clinic end generated code: output=06bf574d5497dbc6 input=26e1e0154aed06ed]*/
+{
+    if (!PyModule_Check(mod)) {
+        PyErr_Format(PyExc_TypeError,
+                     "lazy loading requires a module, not %.200s",
+                     Py_TYPE(mod)->tp_name);
+        return NULL;
+    }
+    return _PyModule_SetLazy(mod);
+}
+
 /* Helper for sys */
 
 PyObject *
@@ -1344,8 +1370,10 @@ static PyObject *
 unmarshal_frozen_code(struct frozen_info *info)
 {
     if (info->get_code) {
+        /* Deep-frozen application modules initialize their code objects
+           lazily, which may fail. */
         PyObject *code = info->get_code();
-        assert(code != NULL);
+        assert(code != NULL || PyErr_Occurred());
         return code;
     }
     PyObject *co = PyMarshal_ReadObjectFromString(info->data, info->size);
@@ -2499,6 +2527,7 @@ static PyMethodDef imp_methods[] = {
     _IMP__FIX_CO_FILENAME_METHODDEF
     _IMP_SOURCE_HASH_METHODDEF
     _IMP_MODULE_INITIALIZED_METHODDEF
+    _IMP_MODULE_SET_LAZY_METHODDEF
     {NULL, NULL}  /* sentinel */
 };
 
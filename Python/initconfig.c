@@ -149,6 +149,10 @@ static const char usage_envvars[] =
 "               The default module search path uses %s.\n"
 "PYTHONPLATLIBDIR : override sys.platlibdir.\n"
 "PYTHONCASEOK : ignore case in 'import' statements (Windows).\n"
+"PYTHONPATHINDEX: file in which directory listings of sys.path entries are\n"
+"   cached across processes (no default).\n"
+"PYTHONSTARTUPCACHE: directory in which the path configuration and site\n"
+"   lookups are cached across processes (no default).\n"
 "PYTHONUTF8: if set to 1, enable the UTF-8 mode.\n"
 "PYTHONIOENCODING: Encoding[:errors] used for stdin/stdout/stderr.\n"
 "PYTHONFAULTHANDLER: dump the Python traceback on fatal errors.\n"
@@ -5,6 +5,7 @@
 #include "pycore_ceval.h"
 #include "pycore_code.h"           // stats
 #include "pycore_critical_section.h"
+#include "pycore_dict.h"          // _PyDict_MergeLayoutStats()
 #include "pycore_frame.h"
 #include "pycore_initconfig.h"
 #include "pycore_lock.h"          // _PyRawEvent
@@ -1405,6 +1406,7 @@ PyThreadState_Clear(PyThreadState *tstate)
     _PyFloat_ClearFreeList(tstate);
     _PyList_ClearFreeList(tstate);
     _PyDict_ClearFreeList(tstate);
+    _PyGen_ClearFreeList(tstate);
     _PyAsyncGen_ClearFreeLists(tstate);
     _PyContext_ClearFreeList(tstate);
 }
@@ -1462,6 +1464,7 @@ tstate_delete_common(PyThreadState *tstate,
     runtime->ref_total += tstate->ref_total;
     tstate->ref_total = 0;
 #endif
+    _PyDict_MergeLayoutStats(tstate);
 
     if (runtime->stop_the_world_requested &&
         tstate->status != _Py_THREAD_GC &&
@@ -1496,6 +1499,11 @@ tstate_delete_common(PyThreadState *tstate,
         _PyObject_VirtualFree(chunk, chunk->size);
         chunk = prev;
     }
+    chunk = tstate_impl->datastack_cached_chunk;
+    tstate_impl->datastack_cached_chunk = NULL;
+    if (chunk != NULL) {
+        _PyObject_VirtualFree(chunk, chunk->size);
+    }
 }
 
 static void
@@ -2760,9 +2768,21 @@ push_chunk(PyThreadState *tstate, int size)
     while (allocate_size < (int)sizeof(PyObject*)*(size + MINIMUM_OVERHEAD)) {
         allocate_size *= 2;
     }
-    _PyStackChunk *new = allocate_chunk(allocate_size, tstate->datastack_chunk);
-    if (new == NULL) {
-        return NULL;
+    _PyStackChunk *new;
+    PyThreadStateImpl *tstate_impl = (PyThreadStateImpl *)tstate;
+    _PyStackChunk *cached = tstate_impl->datastack_cached_chunk;
+    if (cached != NULL && cached->size >= (size_t)allocate_size) {
+        tstate_impl->datastack_cached_chunk = NULL;
+        new = cached;
+        new->previous = tstate->datastack_chunk;
+        new->top = 0;
+        allocate_size = (int)new->size;
+    }
+    else {
+        new = allocate_chunk(allocate_size, tstate->datastack_chunk);
+        if (new == NULL) {
+            return NULL;
+        }
     }
     if (tstate->datastack_chunk) {
         tstate->datastack_chunk->top = tstate->datastack_top -
@@ -2802,8 +2822,20 @@ _PyThreadState_PopFrame(PyThreadState *tstate, _PyInterpreterFrame * frame)
         assert(previous);
         tstate->datastack_top = &previous->data[previous->top];
         tstate->datastack_chunk = previous;
-        _PyObject_VirtualFree(chunk, chunk->size);
         tstate->datastack_limit = (PyObject **)(((char *)previous) + previous->size);
+        // Keep the chunk around for the next push_chunk(), replacing a
+        // smaller cached one.
+        PyThreadStateImpl *tstate_impl = (PyThreadStateImpl *)tstate;
+        _PyStackChunk *cached = tstate_impl->datastack_cached_chunk;
+        if (cached != NULL && cached->size > chunk->size) {
+            _PyObject_VirtualFree(chunk, chunk->size);
+        }
+        else {
+            if (cached != NULL) {
+                _PyObject_VirtualFree(cached, cached->size);
+            }
+            tstate_impl->datastack_cached_chunk = chunk;
+        }
     }
     else {
         assert(tstate->datastack_top);
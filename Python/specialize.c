@@ -1,5 +1,6 @@
 #include "Python.h"
 #include "pycore_code.h"
+#include "pycore_critical_section.h" // Py_BEGIN_CRITICAL_SECTION()
 #include "pycore_dict.h"
 #include "pycore_function.h"      // _PyFunction_GetVersionForCurrentState()
 #include "pycore_global_strings.h"  // _Py_ID()
@@ -163,6 +164,7 @@ print_call_stats(FILE *out, CallStats *stats)
     fprintf(out, "Calls to Python functions inlined: %" PRIu64 "\n", stats->inlined_py_calls);
     fprintf(out, "Frames pushed: %" PRIu64 "\n", stats->frames_pushed);
     fprintf(out, "Frame objects created: %" PRIu64 "\n", stats->frame_objects_created);
+    fprintf(out, "Frame objects created for tracebacks: %" PRIu64 "\n", stats->frame_objects_for_traceback);
     for (int i = 0; i < EVAL_CALL_KINDS; i++) {
         fprintf(out, "Calls via PyEval_EvalFrame[%d] : %" PRIu64 "\n", i, stats->eval_calls[i]);
     }
@@ -303,6 +305,26 @@ _PyCode_Quicken(PyCodeObject *code)
         }
         previous_opcode = opcode;
     }
+    // Undo the lazy-quickening marker set by init_code(), last, so that
+    // threads only run past it once the code is fully quickened:
+    int entry = code->_co_firsttraceable;
+    if (entry < Py_SIZE(code) && instructions[entry].opcode == RESUME_QUICKEN) {
+        _Py_atomic_store_uint8(&instructions[entry].opcode, RESUME);
+    }
+}
+
+// Quicken code that init_code() left for its first execution (see
+// RESUME_QUICKEN). The code object may already be shared, so threads that
+// reach the marker at the same time quicken it once, under its lock.
+void
+_PyCode_QuickenOnce(PyCodeObject *code)
+{
+    _Py_CODEUNIT *entry = &_PyCode_CODE(code)[code->_co_firsttraceable];
+    Py_BEGIN_CRITICAL_SECTION(code);
+    if (_Py_atomic_load_uint8(&entry->opcode) == RESUME_QUICKEN) {
+        _PyCode_Quicken(code);
+    }
+    Py_END_CRITICAL_SECTION;
 }
 
 #define SIMPLE_FUNCTION 0
@@ -491,6 +513,11 @@ specialize_module_load_attr(
         SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_NON_STRING_OR_SPLIT);
         return -1;
     }
+    if (_PyModule_IsLazy(owner)) {
+        // The attribute lookup must load the module first
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OTHER);
+        return -1;
+    }
     Py_ssize_t index = _PyDict_LookupIndex(dict, &_Py_ID(__getattr__));
     assert(index != DKIX_ERROR);
     if (index != DKIX_EMPTY) {
@@ -17,6 +17,7 @@ Data members:
 #include "Python.h"
 #include "pycore_call.h"          // _PyObject_CallNoArgs()
 #include "pycore_ceval.h"         // _PyEval_SetAsyncGenFinalizer()
+#include "pycore_dict.h"          // _PyDict_GetLayoutStats()
 #include "pycore_frame.h"         // _PyInterpreterFrame
 #include "pycore_initconfig.h"    // _PyStatus_EXCEPTION()
 #include "pycore_long.h"          // _PY_LONG_MAX_STR_DIGITS_THRESHOLD
@@ -2091,6 +2092,27 @@ sys__clear_type_cache_impl(PyObject *module)
     Py_RETURN_NONE;
 }
 
+/*[clinic input]
+sys._dict_layout_stats
+
+Return a dict of counters on how instance dicts share the keys of their class.
+
+"unshared" counts the instance dicts that were converted from shared keys
+to a table of their own, "unshared_keys_full" and
+"unshared_incompatible_key" those of them converted because the shared
+keys had no room left for a new attribute or because a key was not an
+interned str.  "materialized" counts the dicts created from the inline
+attribute values of instances, and "prepopulated_keys" the attribute names
+added to the shared keys of classes before their first instance was created.
+[clinic start generated code]*/
+
+static PyObject *
+sys__dict_layout_stats_impl(PyObject *module)
+/*[clinic end generated code: output=bf2f20bd2139fea1 input=9bccb06430d56402]*/
+{
+    return _PyDict_GetLayoutStats();
+}
+
 /*[clinic input]
 sys.is_finalizing
 
@@ -2262,6 +2284,7 @@ static PyMethodDef sys_methods[] = {
     {"breakpointhook", _PyCFunction_CAST(sys_breakpointhook),
      METH_FASTCALL | METH_KEYWORDS, breakpointhook_doc},
     SYS__CLEAR_TYPE_CACHE_METHODDEF
+    SYS__DICT_LAYOUT_STATS_METHODDEF
     SYS__CURRENT_FRAMES_METHODDEF
     SYS__CURRENT_EXCEPTIONS_METHODDEF
     SYS_DISPLAYHOOK_METHODDEF
@@ -0,0 +1,160 @@
+"""Benchmark arithmetic on very large ints.
+
+Each benchmark builds random operands of about the given number of decimal
+digits once and times an operation on them: multiplication, squaring,
+division, conversion to and from decimal strings, powers, factorials and
+sums of fractions.  These exercise the Karatsuba, Toom-3 and NTT
+multiplication and Newton division in Objects/longobject.c.
+
+"""
+import argparse
+import fractions
+import json
+import math
+import random
+import sys
+import time
+
+
+def bits(digits):
+    return int(digits * 3.3219280948873626) + 1
+
+
+def mul(n):
+    """product of two ints of n digits."""
+    a = random.getrandbits(bits(n))
+    b = random.getrandbits(bits(n))
+    return lambda: a * b
+
+
+def lopsided(n):
+    """product of ints of n and n/10 digits."""
+    a = random.getrandbits(bits(n))
+    b = random.getrandbits(bits(n // 10))
+    return lambda: a * b
+
+
+def square(n):
+    """square of an int of n digits."""
+    a = random.getrandbits(bits(n))
+    return lambda: a * a
+
+
+def divmod_(n):
+    """divmod() of an int of 2n digits by one of n digits."""
+    a = random.getrandbits(bits(2 * n))
+    b = random.getrandbits(bits(n))
+    return lambda: divmod(a, b)
+
+
+def str_(n):
+    """str() of an int of n digits."""
+    a = random.getrandbits(bits(n))
+    return lambda: str(a)
+
+
+def int_(n):
+    """int() of a string of n decimal digits."""
+    s = str(random.getrandbits(bits(n)))
+    return lambda: int(s)
+
+
+def pow_(n):
+    """3 ** k with n digits."""
+    k = bits(n) * 2 // 3
+    return lambda: 3 ** k
+
+
+def factorial(n):
+    """math.factorial() with n digits."""
+    k = 10
+    while math.lgamma(k + 1) / math.log(10) < n:
+        k *= 2
+    return lambda: math.factorial(k)
+
+
+def fraction_sum(n):
+    """sum of fractions with denominators of n/100 digits."""
+    rng = random.Random(0)
+    terms = [fractions.Fraction(rng.getrandbits(bits(n // 100)),
+                                rng.getrandbits(bits(n // 100)) | 1)
+             for _ in range(100)]
+    return lambda: sum(terms)
+
+
+BENCHMARKS = {
+    "mul": mul,
+    "lopsided": lopsided,
+    "square": square,
+    "divmod": divmod_,
+    "str": str_,
+    "int": int_,
+    "pow": pow_,
+    "factorial": factorial,
+    "fractions": fraction_sum,
+}
+
+
+def best_of(func, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - t0)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", "--size", type=int, action="append",
+                        help="number of decimal digits of the operands; may "
+                             "be given several times (default: 10000, "
+                             "100000 and 1000000)")
+    parser.add_argument("-r", "--repeat", type=int, default=3,
+                        help="number of timings to take the best of "
+                             "(default: 3)")
+    parser.add_argument("--read", dest="source_file",
+                        type=argparse.FileType("r"),
+                        help="file to read results from to compare against")
+    parser.add_argument("-w", "--write", dest="dest_file",
+                        type=argparse.FileType("w"),
+                        help="file to write results to")
+    parser.add_argument("benchmarks", nargs="*", metavar="benchmark",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(BENCHMARKS)})")
+    options = parser.parse_args()
+
+    names = options.benchmarks or list(BENCHMARKS)
+    for name in names:
+        if name not in BENCHMARKS:
+            parser.error(f"unknown benchmark: {name!r}")
+    sizes = options.size or [10_000, 100_000, 1_000_000]
+    prev_results = {}
+    if options.source_file:
+        with options.source_file:
+            prev_results = json.load(options.source_file)
+
+    if hasattr(sys, "set_int_max_str_digits"):
+        sys.set_int_max_str_digits(0)
+    random.seed(0)
+    results = {}
+    for size in sizes:
+        for name in names:
+            func = BENCHMARKS[name](size)
+            label = f"{name}/{size}"
+            seconds = results[label] = best_of(func, options.repeat)
+            line = f"{label:20} {seconds * 1000:10.2f} ms"
+            old = prev_results.get(label)
+            if old:
+                line += f"  ({old / seconds:.2f}x vs. {old * 1000:.2f} ms)"
+            print(f"{line}  {BENCHMARKS[name].__doc__}")
+            sys.stdout.flush()
+            del func
+
+    if options.dest_file:
+        with options.dest_file:
+            json.dump(results, options.dest_file, indent=2)
+
+
+if __name__ == "__main__":
+    main()
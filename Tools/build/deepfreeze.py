@@ -10,6 +10,7 @@
 import builtins
 import collections
 import contextlib
+import io
 import os
 import re
 import time
@@ -21,6 +22,9 @@
 
 verbose = False
 identifiers, strings = get_identifiers_and_strings()
+# The global strings are spelled as C string literals.
+strings = {s.encode('ascii').decode('unicode_escape'): name
+           for s, name in strings.items()}
 
 # This must be kept in sync with opcode.py
 RESUME = 151
@@ -107,19 +111,32 @@ def removesuffix(base: str, suffix: str) -> str:
 
 class Printer:
 
-    def __init__(self, file: TextIO) -> None:
+    def __init__(self, file: TextIO, app: bool = False) -> None:
         self.level = 0
         self.file = file
+        # In app mode the output is compiled outside the core and linked
+        # into a custom binary next to the interpreter's own deepfreeze.c.
+        self.app = app
         self.cache: Dict[tuple[type, object, str], str] = {}
         self.hits, self.misses = 0, 0
         self.finis: list[str] = []
         self.inits: list[str] = []
+        if app:
+            self.write('#define Py_BUILD_CORE 1')
         self.write('#include "Python.h"')
         self.write('#include "internal/pycore_gc.h"')
         self.write('#include "internal/pycore_code.h"')
         self.write('#include "internal/pycore_frame.h"')
         self.write('#include "internal/pycore_long.h"')
         self.write("")
+        if app:
+            self.write("static int app_deepfreeze_init(void);")
+            self.write("static void app_deepfreeze_fini(void);")
+            self.write("")
+            with self.block("static _PyStaticCodeSet app_static_code =", ";"):
+                self.write(".init = app_deepfreeze_init,")
+                self.write(".fini = app_deepfreeze_fini,")
+            self.write("")
 
     @contextlib.contextmanager
     def indent(self) -> None:
@@ -268,8 +285,13 @@ def generate_code(self, name: str, code: types.CodeType) -> str:
             self.field(code, "co_nlocals")
             self.write(f".co_ncellvars = {ncellvars},")
             self.write(f".co_nfreevars = {nfreevars},")
-            self.write(f".co_version = {next_code_version},")
-            next_code_version += 1
+            if self.app:
+                # The interpreter's static code objects already use the
+                # versions from 1 up; _PyStaticCode_Init() assigns one.
+                self.write(".co_version = 0,")
+            else:
+                self.write(f".co_version = {next_code_version},")
+                next_code_version += 1
             self.write(f".co_localsplusnames = {co_localsplusnames},")
             self.write(f".co_localspluskinds = {co_localspluskinds},")
             self.write(f".co_filename = {co_filename},")
@@ -372,7 +394,8 @@ def generate_frozenset(self, name: str, fs: FrozenSet[object]) -> str:
     def generate_file(self, module: str, code: object)-> None:
         module = module.replace(".", "_")
         self.generate(f"{module}_toplevel", code)
-        self.write(EPILOGUE.format(name=module))
+        epilogue = APP_EPILOGUE if self.app else EPILOGUE
+        self.write(epilogue.format(name=module))
 
     def generate(self, name: str, obj: object) -> str:
         # Use repr() in the key to distinguish -0.0 from +0.0
@@ -422,6 +445,17 @@ def generate(self, name: str, obj: object) -> str:
 }}
 """
 
+APP_EPILOGUE = """
+PyObject *
+_PyApp_get_{name}_toplevel(void)
+{{
+    if (_PyStaticCode_InitSet(&app_static_code) < 0) {{
+        return NULL;
+    }}
+    return Py_NewRef((PyObject *) &{name}_toplevel);
+}}
+"""
+
 FROZEN_COMMENT_C = "/* Auto-generated by Programs/_freeze_module.c */"
 FROZEN_COMMENT_PY = "/* Auto-generated by Programs/_freeze_module.py */"
 
@@ -452,7 +486,7 @@ def generate(args: list[str], output: TextIO) -> None:
             if is_frozen_header(source):
                 code = decode_frozen_data(source)
             else:
-                code = compile(fd.read(), f"<frozen {modname}>", "exec")
+                code = compile(source, f"<frozen {modname}>", "exec")
             printer.generate_file(modname, code)
     with printer.block(f"void\n_Py_Deepfreeze_Fini(void)"):
         for p in printer.finis:
@@ -467,9 +501,67 @@ def generate(args: list[str], output: TextIO) -> None:
         print(f"Cache hits: {printer.hits}, misses: {printer.misses}")
 
 
+def generate_app(modules: Dict[str, types.CodeType], output: TextIO) -> list[str]:
+    """Deep-freeze application modules for a custom binary.
+
+    *modules* maps module names to their code objects.  For each module,
+    the output defines _PyApp_get_<name>_toplevel(), to be used as the
+    get_code function of its PyImport_FrozenModules entry.  The code
+    objects are initialized when the first of them is asked for, and
+    finalized by Py_Finalize().
+
+    Modules containing constants that cannot be deep-frozen (such as
+    strings with lone surrogates) are skipped.  Returns the names of the
+    modules that were frozen.
+    """
+    buffer = io.StringIO()
+    printer = Printer(buffer, app=True)
+    frozen = []
+    for modname, code in modules.items():
+        state = (buffer.tell(), len(printer.cache), len(printer.inits),
+                 len(printer.finis))
+        try:
+            printer.generate_file(modname, code)
+        except (TypeError, ValueError) as exc:
+            if verbose:
+                print(f"Not deep-freezing {modname}: {exc}")
+            pos, ncached, ninits, nfinis = state
+            buffer.seek(pos)
+            buffer.truncate()
+            for key in list(printer.cache)[ncached:]:
+                del printer.cache[key]
+            del printer.inits[ninits:]
+            del printer.finis[nfinis:]
+        else:
+            frozen.append(modname)
+    with printer.block(f"static void\napp_deepfreeze_fini(void)"):
+        for p in printer.finis:
+            printer.write(p)
+    with printer.block(f"static int\napp_deepfreeze_init(void)"):
+        for p in printer.inits:
+            with printer.block(f"if ({p} < 0)"):
+                printer.write("return -1;")
+        printer.write("return 0;")
+    output.write(buffer.getvalue())
+    if verbose:
+        print(f"Cache hits: {printer.hits}, misses: {printer.misses}")
+    return frozen
+
+
+def generate_app_files(args: list[str], output: TextIO) -> None:
+    modules = {}
+    for arg in args:
+        file, modname = arg.rsplit(':', 1)
+        with open(file, "r", encoding="utf8") as fd:
+            modules[modname] = compile(fd.read(), file, "exec")
+    generate_app(modules, output)
+
+
 parser = argparse.ArgumentParser()
 parser.add_argument("-o", "--output", help="Defaults to deepfreeze.c", default="deepfreeze.c")
 parser.add_argument("-v", "--verbose", action="store_true", help="Print diagnostics")
+parser.add_argument("--app", action="store_true",
+                    help="Freeze application modules for a custom binary")
 parser.add_argument('args', nargs="+", help="Input file and module name (required) in file:modname format")
 
 @contextlib.contextmanager
@@ -490,7 +582,10 @@ def main() -> None:
     output = args.output
     with open(output, "w", encoding="utf-8") as file:
         with report_time("generate"):
-            generate(args.args, file)
+            if args.app:
+                generate_app_files(args.args, file)
+            else:
+                generate(args.args, file)
     if verbose:
         print(f"Wrote {os.path.getsize(output)} bytes to {output}")
 
@@ -125,6 +125,31 @@ def compute(s):
     return compute, (arg, )
 
 
+def task_list_append():
+    """shared list append (C)"""
+    shared = []
+    items = list(range(1000))
+
+    def append(l, items):
+        _append = l.append
+        for x in items:
+            _append(x)
+        if len(l) > 100000:
+            del l[:]
+    return append, (shared, items)
+
+def task_list_index():
+    """shared list indexing (C)"""
+    shared = list(range(1000))
+
+    def index(l):
+        for i in xrange(len(l)):
+            l[i]
+        for x in l:
+            pass
+    return index, (shared, )
+
+
 throughput_tasks = [task_pidigits, task_regex]
 for mod in 'bz2', 'hashlib':
     try:
@@ -143,6 +168,8 @@ def compute(s):
     throughput_tasks.append(task_compress_zlib)
 
 latency_tasks = throughput_tasks
+# Contended access to a single list shared by all threads
+list_tasks = [task_list_append, task_list_index]
 bandwidth_tasks = [task_pidigits]
 
 
@@ -237,8 +264,8 @@ def run():
 
     return results
 
-def run_throughput_tests(max_threads):
-    for task in throughput_tasks:
+def run_throughput_tests(max_threads, tasks=throughput_tasks):
+    for task in tasks:
         print(task.__doc__)
         print()
         func, args = task()
@@ -532,6 +559,9 @@ def main():
     parser.add_option("-b", "--bandwidth",
                       action="store_true", dest="bandwidth", default=False,
                       help="run I/O bandwidth tests")
+    parser.add_option("-s", "--lists",
+                      action="store_true", dest="lists", default=False,
+                      help="run shared list throughput tests")
     parser.add_option("-i", "--interval",
                       action="store", type="int", dest="check_interval", default=None,
                       help="sys.setcheckinterval() value "
@@ -566,7 +596,8 @@ def main():
         bandwidth_client(**kwargs)
         return
 
-    if not options.throughput and not options.latency and not options.bandwidth:
+    if not (options.throughput or options.latency or options.bandwidth
+            or options.lists):
         options.throughput = options.latency = options.bandwidth = True
     if options.check_interval:
         sys.setcheckinterval(options.check_interval)
@@ -592,6 +623,11 @@ def main():
         print()
         run_throughput_tests(options.nthreads)
 
+    if options.lists:
+        print("--- Shared list throughput ---")
+        print()
+        run_throughput_tests(options.nthreads, list_tasks)
+
     if options.latency:
         print("--- Latency ---")
         print()
@@ -0,0 +1,171 @@
+"""Benchmark the compiler on large synthetic modules.
+
+Each benchmark generates the source of a big module, similar in shape to
+machine-generated code (protocol buffer bindings, ORM models, lookup
+tables), and times the stages of compiling it: parsing the source to an
+AST, building the symbol table, and compiling the AST to a code object.
+
+"""
+import argparse
+import ast
+import json
+import sys
+import symtable
+import time
+
+
+def protobuf_module(n):
+    """Message classes with many fields and accessors."""
+    lines = ["import enum", ""]
+    for i in range(n):
+        lines.append(f"class Message{i}:")
+        lines.append(f"    __slots__ = ({', '.join(repr(f'_f{j}') for j in range(20))},)")
+        lines.append(f"    DESCRIPTOR = {{'name': 'Message{i}', 'fields': [")
+        for j in range(20):
+            lines.append(f"        ('f{j}', {j + 1}, 'TYPE_{j % 5}', {j % 3 == 0}),")
+        lines.append("    ]}")
+        lines.append("    def __init__(self, *, " +
+                     ", ".join(f"f{j}=None" for j in range(20)) + "):")
+        for j in range(20):
+            lines.append(f"        self._f{j} = f{j}")
+        for j in range(20):
+            lines.append(f"    @property")
+            lines.append(f"    def f{j}(self):")
+            lines.append(f"        return self._f{j}")
+        lines.append("    def serialize(self, out):")
+        for j in range(20):
+            lines.append(f"        if self._f{j} is not None:")
+            lines.append(f"            out.append(({j + 1}, self._f{j}))")
+        lines.append("        return out")
+        lines.append("")
+    return "\n".join(lines)
+
+
+def orm_module(n):
+    """Model classes whose bodies are long runs of keyword-heavy calls."""
+    lines = ["from orm import Model, Column, ForeignKey, Integer, String", ""]
+    for i in range(n):
+        lines.append(f"class Table{i}(Model):")
+        lines.append(f"    __tablename__ = 'table_{i}'")
+        for j in range(30):
+            lines.append(f"    column_{j} = Column('column_{j}', "
+                         f"{'Integer' if j % 2 else 'String'}({j + 8}), "
+                         f"nullable={j % 3 == 0}, index={j % 5 == 0}, "
+                         f"default={j}, doc='column {j} of table {i}')")
+        lines.append(f"    parent_id = Column(Integer, ForeignKey('table_{max(i - 1, 0)}.id'))")
+        lines.append("")
+    return "\n".join(lines)
+
+
+def dispatch_module(n):
+    """A few huge functions made of if/elif chains and loops."""
+    lines = []
+    for i in range(n // 50 or 1):
+        lines.append(f"def dispatch{i}(op, a, b):")
+        lines.append("    result = 0")
+        for j in range(500):
+            kw = "if" if j == 0 else "elif"
+            lines.append(f"    {kw} op == {j}:")
+            lines.append(f"        for x in range(a):")
+            lines.append(f"            if x % {j + 2} and b:")
+            lines.append(f"                result += x * {j}")
+            lines.append(f"            else:")
+            lines.append(f"                break")
+        lines.append("    else:")
+        lines.append("        raise ValueError(op)")
+        lines.append("    return result")
+        lines.append("")
+    return "\n".join(lines)
+
+
+def table_module(n):
+    """Large constant tables: dict, list and tuple literals."""
+    lines = ["TABLE = {"]
+    for i in range(n * 50):
+        lines.append(f"    'key{i}': ({i}, {i * 0.5}, 'value{i}', b'raw{i}'),")
+    lines.append("}")
+    lines.append("ROWS = [")
+    for i in range(n * 50):
+        lines.append(f"    [{i}, {i + 1}, {i + 2}, 'x{i}'],")
+    lines.append("]")
+    return "\n".join(lines)
+
+
+BENCHMARKS = {
+    "protobuf": protobuf_module,
+    "orm": orm_module,
+    "dispatch": dispatch_module,
+    "table": table_module,
+}
+
+
+def best_of(func, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - t0)
+    return best
+
+
+def bench(name, source, repeat):
+    filename = f"<{name}>"
+    tree = ast.parse(source, filename)
+    return {
+        "parse": best_of(lambda: ast.parse(source, filename), repeat),
+        "symtable": best_of(lambda: symtable.symtable(source, filename, "exec"),
+                            repeat),
+        "compile AST": best_of(lambda: compile(tree, filename, "exec"), repeat),
+        "compile source": best_of(lambda: compile(source, filename, "exec"),
+                                  repeat),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", "--size", type=int, default=200,
+                        help="size of the generated modules (default: 200)")
+    parser.add_argument("-r", "--repeat", type=int, default=3,
+                        help="number of timings to take the best of "
+                             "(default: 3)")
+    parser.add_argument("--read", dest="source_file",
+                        type=argparse.FileType("r"),
+                        help="file to read results from to compare against")
+    parser.add_argument("-w", "--write", dest="dest_file",
+                        type=argparse.FileType("w"),
+                        help="file to write results to")
+    parser.add_argument("benchmarks", nargs="*", metavar="benchmark",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(BENCHMARKS)})")
+    options = parser.parse_args()
+
+    names = options.benchmarks or list(BENCHMARKS)
+    for name in names:
+        if name not in BENCHMARKS:
+            parser.error(f"unknown benchmark: {name!r}")
+    prev_results = {}
+    if options.source_file:
+        with options.source_file:
+            prev_results = json.load(options.source_file)
+
+    results = {}
+    for name in names:
+        source = BENCHMARKS[name](options.size)
+        print(f"{name}: {len(source) // 1024} KiB, "
+              f"{source.count(chr(10)) + 1} lines")
+        results[name] = timings = bench(name, source, options.repeat)
+        for stage, seconds in timings.items():
+            line = f"    {stage:15} {seconds * 1000:10.1f} ms"
+            old = prev_results.get(name, {}).get(stage)
+            if old:
+                line += f"  ({old / seconds:.2f}x vs. {old * 1000:.1f} ms)"
+            print(line)
+        sys.stdout.flush()
+
+    if options.dest_file:
+        with options.dest_file:
+            json.dump(results, options.dest_file, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+"""Measure the throughput of the tokenizer and the parser in MB/s.
+
+The sources of all .py files under the given directories (by default the
+standard library) are read into memory and then tokenized with the C
+tokenizer and parsed to ASTs, one file at a time.  Files that fail to
+parse are skipped.
+
+"""
+import argparse
+import ast
+import json
+import os
+import sys
+import time
+import _tokenize
+
+
+def read_sources(paths):
+    sources = []
+    for path in paths:
+        if os.path.isfile(path):
+            files = [path]
+        else:
+            files = sorted(os.path.join(dirpath, name)
+                           for dirpath, _, names in os.walk(path)
+                           for name in names if name.endswith(".py"))
+        for filename in files:
+            try:
+                with open(filename, "rb") as f:
+                    source = f.read()
+                ast.parse(source, filename)
+            except (SyntaxError, ValueError, OSError, RecursionError):
+                continue
+            sources.append((filename, source))
+    return sources
+
+
+def tokenize_all(sources):
+    for filename, source in sources:
+        for _ in _tokenize.TokenizerIter(source.decode("utf-8", "replace")):
+            pass
+
+
+def parse_all(sources):
+    for filename, source in sources:
+        ast.parse(source, filename)
+
+
+def compile_all(sources):
+    for filename, source in sources:
+        compile(source, filename, "exec")
+
+
+STAGES = {
+    "tokenize": tokenize_all,
+    "parse": parse_all,
+    "compile": compile_all,
+}
+
+
+def best_of(func, sources, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        func(sources)
+        best = min(best, time.perf_counter() - t0)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-r", "--repeat", type=int, default=3,
+                        help="number of timings to take the best of "
+                             "(default: 3)")
+    parser.add_argument("--read", dest="source_file",
+                        type=argparse.FileType("r"),
+                        help="file to read results from to compare against")
+    parser.add_argument("-w", "--write", dest="dest_file",
+                        type=argparse.FileType("w"),
+                        help="file to write results to")
+    parser.add_argument("paths", nargs="*", metavar="path",
+                        help="files and directories to read the sources "
+                             "from (default: the standard library)")
+    options = parser.parse_args()
+
+    paths = options.paths or [os.path.dirname(os.__file__)]
+    sources = read_sources(paths)
+    size = sum(len(source) for _, source in sources)
+    print(f"{len(sources)} files, {size / 1e6:.1f} MB")
+    prev_results = {}
+    if options.source_file:
+        with options.source_file:
+            prev_results = json.load(options.source_file)
+
+    results = {}
+    for stage, func in STAGES.items():
+        seconds = best_of(func, sources, options.repeat)
+        results[stage] = throughput = size / seconds / 1e6
+        line = f"    {stage:10} {throughput:8.2f} MB/s"
+        old = prev_results.get(stage)
+        if old:
+            line += f"  ({throughput / old:.2f}x vs. {old:.2f} MB/s)"
+        print(line)
+        sys.stdout.flush()
+
+    if options.dest_file:
+        with options.dest_file:
+            json.dump(results, options.dest_file, indent=2)
+
+
+if __name__ == "__main__":
+    main()
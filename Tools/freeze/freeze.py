@@ -51,6 +51,10 @@
 -E:           Freeze will fail if any modules can't be found (that
               were not excluded using -x or -X).
 
+-D:           Deep-freeze the modules: they are compiled into static code
+              objects, so importing them does not unmarshal anything.
+              Requires the Python source tree that freeze belongs to.
+
 -i filename:  Include a file with additional command line options.  Used
               to prevent command lines growing beyond the capabilities of
               the shell/OS.  All arguments specified in filename
@@ -122,6 +126,7 @@ def main():
     win = sys.platform[:3] == 'win'
     replace_paths = []                  # settable with -r option
     error_if_any_missing = 0
+    deepfreeze = 0                      # settable with -D option
 
     # default the exclude list for each platform
     if win: exclude = exclude + [
@@ -155,7 +160,7 @@ def main():
 
     # Now parse the command line with the extras inserted.
     try:
-        opts, args = getopt.getopt(sys.argv[1:], 'r:a:dEe:hmo:p:P:qs:wX:x:l:')
+        opts, args = getopt.getopt(sys.argv[1:], 'r:a:dDEe:hmo:p:P:qs:wX:x:l:')
     except getopt.error as msg:
         usage('getopt error: ' + str(msg))
 
@@ -191,6 +196,8 @@ def main():
             fail_import.append(a)
         if o == '-E':
             error_if_any_missing = 1
+        if o == '-D':
+            deepfreeze = 1
         if o == '-l':
             addn_link.append(a)
         if o == '-a':
@@ -385,7 +392,7 @@ def main():
 
     # generate output for frozen modules
     files = makefreeze.makefreeze(base, dict, debug, custom_entry_point,
-                                  fail_import)
+                                  fail_import, deepfreeze)
 
     # look for unfrozen modules (builtin and of unknown origin)
     builtins = []
@@ -1,12 +1,16 @@
 import marshal
+import os
+import sys
 import bkfile
 
 
 # Write a file containing frozen code for the modules in the dictionary.
 
-header = """
+prologue = """\
 #include "Python.h"
 
+"""
+header = """
 static struct _frozen _PyImport_FrozenModules[] = {
 """
 trailer = """\
@@ -29,15 +33,23 @@
 
 """
 
-def makefreeze(base, dict, debug=0, entry_point=None, fail_import=()):
+def makefreeze(base, dict, debug=0, entry_point=None, fail_import=(),
+               deepfreeze=False):
     if entry_point is None: entry_point = default_entry_point
     done = []
     files = []
     mods = sorted(dict.keys())
+    deepfrozen = ()
+    if deepfreeze:
+        file, deepfrozen = makedeepfreeze(base, dict, debug)
+        files.append(file)
     for mod in mods:
         m = dict[mod]
         mangled = "__".join(mod.split("."))
-        if m.__code__:
+        if mod in deepfrozen:
+            is_package = '1' if m.__path__ else '0'
+            done.append((mod, mangled, None, is_package))
+        elif m.__code__:
             file = 'M_' + mangled + '.c'
             with bkfile.open(base + file, 'w') as outfp:
                 files.append(file)
@@ -53,11 +65,21 @@ def makefreeze(base, dict, debug=0, entry_point=None, fail_import=()):
     if debug:
         print("generating table of frozen modules")
     with bkfile.open(base + 'frozen.c', 'w') as outfp:
+        outfp.write(prologue)
         for mod, mangled, size, _ in done:
-            outfp.write('extern unsigned char M_%s[];\n' % mangled)
+            if size is None:
+                outfp.write('extern PyObject *_PyApp_get_%s_toplevel(void);\n'
+                            % mod.replace('.', '_'))
+            else:
+                outfp.write('extern unsigned char M_%s[];\n' % mangled)
         outfp.write(header)
         for mod, mangled, size, is_package in done:
-            outfp.write('\t{"%s", M_%s, %d, %s},\n' % (mod, mangled, size, is_package))
+            if size is None:
+                # Deep-frozen: no marshal data, only a get_code function.
+                outfp.write('\t{"%s", NULL, 0, %s, _PyApp_get_%s_toplevel},\n'
+                            % (mod, is_package, mod.replace('.', '_')))
+            else:
+                outfp.write('\t{"%s", M_%s, %d, %s},\n' % (mod, mangled, size, is_package))
         outfp.write('\n')
         # The following modules have a NULL code pointer, indicating
         # that the frozen program should not search for them on the host
@@ -71,6 +93,31 @@ def makefreeze(base, dict, debug=0, entry_point=None, fail_import=()):
 
 
 
+# Write deepfreeze.c, with static code objects for all the modules in the
+# dictionary, using Tools/build/deepfreeze.py from the same source tree.
+
+def makedeepfreeze(base, dict, debug=0):
+    build_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                             os.pardir, 'build')
+    sys.path.insert(0, build_dir)
+    try:
+        import deepfreeze
+    finally:
+        del sys.path[0]
+    modules = {mod: dict[mod].__code__ for mod in sorted(dict.keys())
+               if dict[mod].__code__}
+    if debug:
+        print("deep-freezing", len(modules), "modules ...")
+    file = 'deepfreeze.c'
+    with bkfile.open(base + file, 'w') as outfp:
+        frozen = deepfreeze.generate_app(modules, outfp)
+    if debug and len(frozen) < len(modules):
+        print("could not deep-freeze", len(modules) - len(frozen),
+              "modules, marshalling them instead")
+    return file, set(frozen)
+
+
+
 # Write a C initializer for a module containing the frozen python code.
 # The array is called M_<mod>.
 
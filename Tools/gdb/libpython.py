@@ -782,8 +782,16 @@ def iteritems(self):
                 yield item
             return
         entries, nentries = self._get_entries(keys)
+        oldkeys = self._get_oldkeys(keys)
+        if oldkeys is not None:
+            # An incremental resize is in progress: entries that were not
+            # moved yet are still in the old table, at the same position.
+            old_entries, old_nentries = self._get_entries(oldkeys)
         for i in safe_range(nentries):
             ep = entries[i]
+            if (oldkeys is not None and i < old_nentries
+                    and int(ep['me_key']) == 0):
+                ep = old_entries[i]
             pyop_value = PyObjectPtr.from_pyobject_ptr(ep['me_value'])
             if not pyop_value.is_null():
                 pyop_key = PyObjectPtr.from_pyobject_ptr(ep['me_key'])
@@ -844,6 +852,22 @@ def _get_entries(keys):
 
         return ent_addr, dk_nentries
 
+    @staticmethod
+    def _get_oldkeys(keys):
+        # Large combined tables keep the table they are being migrated
+        # from in a trailer after the entries (see _PyDictResizeState in
+        # Objects/dictobject.c).
+        dk_log2_size = int(keys['dk_log2_size'])
+        if dk_log2_size < 17 or int(keys['dk_kind']) == 2:  # DICT_KEYS_SPLIT
+            return None
+        entries, _ = PyDictObjectPtr._get_entries(keys)
+        usable = ((1 << dk_log2_size) << 1) // 3
+        state_addr = (entries + usable).cast(keys.type.pointer())
+        oldkeys = state_addr.dereference()
+        if int(oldkeys) == 0:
+            return None
+        return oldkeys
+
 
 class PyListObjectPtr(PyObjectPtr):
     _typename = 'PyListObject'
@@ -1231,17 +1255,12 @@ def get_truncated_repr(self, maxlen):
 class PySetObjectPtr(PyObjectPtr):
     _typename = 'PySetObject'
 
-    @classmethod
-    def _dummy_key(self):
-        return gdb.lookup_global_symbol('_PySet_Dummy').value()
-
     def __iter__(self):
-        dummy_ptr = self._dummy_key()
         table = self.field('table')
-        for i in safe_range(self.field('mask') + 1):
+        for i in safe_range(self.field('fill')):
             setentry = table[i]
             key = setentry['key']
-            if key != 0 and key != dummy_ptr:
+            if key != 0:
                 yield PyObjectPtr.from_pyobject_ptr(key)
 
     def proxyval(self, visited):
@@ -0,0 +1,126 @@
+"""Benchmark list.sort() on large lists of ints, floats and strings.
+
+Each benchmark builds a list of random keys once and times sorting fresh
+copies of it, with the default arguments, with reverse=True, with a key
+function and with parallel=True.  The time to copy the list is measured
+separately and subtracted.
+
+"""
+import argparse
+import json
+import random
+import sys
+import time
+
+
+def small_ints(n):
+    """ints below 2**30 in absolute value."""
+    return [random.randrange(-2**30 + 1, 2**30) for _ in range(n)]
+
+
+def word_ints(n):
+    """ints below 2**60 in absolute value."""
+    return [random.randrange(-2**60 + 1, 2**60) for _ in range(n)]
+
+
+def few_ints(n):
+    """ints from a range of 1000 values, with many duplicates."""
+    return [random.randrange(1000) for _ in range(n)]
+
+
+def floats(n):
+    """floats spread over many orders of magnitude."""
+    return [random.uniform(-1.0, 1.0) * 10.0 ** random.randrange(-20, 20)
+            for _ in range(n)]
+
+
+def strings(n):
+    """short ASCII strings."""
+    return [str(random.random()) for _ in range(n)]
+
+
+BENCHMARKS = {
+    "small_ints": small_ints,
+    "word_ints": word_ints,
+    "few_ints": few_ints,
+    "floats": floats,
+    "strings": strings,
+}
+
+VARIANTS = {
+    "sort": lambda L: L.sort(),
+    "reverse": lambda L: L.sort(reverse=True),
+    "key": lambda L: L.sort(key=abs if isinstance(L[0], (int, float))
+                            else str.lower),
+    "parallel": lambda L: L.sort(parallel=True),
+}
+
+
+def best_of(func, data, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        L = data[:]
+        t0 = time.perf_counter()
+        func(L)
+        best = min(best, time.perf_counter() - t0)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", "--size", type=int, action="append",
+                        help="number of items to sort; may be given several "
+                             "times (default: 1000000)")
+    parser.add_argument("-r", "--repeat", type=int, default=3,
+                        help="number of timings to take the best of "
+                             "(default: 3)")
+    parser.add_argument("--read", dest="source_file",
+                        type=argparse.FileType("r"),
+                        help="file to read results from to compare against")
+    parser.add_argument("-w", "--write", dest="dest_file",
+                        type=argparse.FileType("w"),
+                        help="file to write results to")
+    parser.add_argument("benchmarks", nargs="*", metavar="benchmark",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(BENCHMARKS)})")
+    options = parser.parse_args()
+
+    names = options.benchmarks or list(BENCHMARKS)
+    for name in names:
+        if name not in BENCHMARKS:
+            parser.error(f"unknown benchmark: {name!r}")
+    sizes = options.size or [1_000_000]
+    prev_results = {}
+    if options.source_file:
+        with options.source_file:
+            prev_results = json.load(options.source_file)
+
+    random.seed(0)
+    results = {}
+    for size in sizes:
+        for name in names:
+            data = BENCHMARKS[name](size)
+            label = f"{name}/{size}"
+            print(f"{label}: {BENCHMARKS[name].__doc__}")
+            results[label] = timings = {}
+            for variant, func in VARIANTS.items():
+                timings[variant] = best_of(func, data, options.repeat)
+            copy = best_of(lambda L: L[:], data, options.repeat)
+            for variant, seconds in timings.items():
+                seconds = max(seconds - copy, 1e-9)
+                timings[variant] = seconds
+                line = f"    {variant:10} {seconds * 1000:10.1f} ms"
+                old = prev_results.get(label, {}).get(variant)
+                if old:
+                    line += f"  ({old / seconds:.2f}x vs. {old * 1000:.1f} ms)"
+                print(line)
+            sys.stdout.flush()
+            del data
+
+    if options.dest_file:
+        with options.dest_file:
+            json.dump(results, options.dest_file, indent=2)
+
+
+if __name__ == "__main__":
+    main()